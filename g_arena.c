@@ -356,6 +356,7 @@ void G_CheckState(arena_t *a) {
         a->countdown = (int) g_round_countdown->value;
 
         G_ClearRoundInfo(a);
+        G_ResumeArena(a);
         G_RespawnPlayers(a);
         G_ForceDemo(a);
         ClockStartRoundCountdown(a);
@@ -397,6 +398,81 @@ void G_ArenaThink(arena_t *a) {
     }
 }
 
+/**
+ * Actually do the queued work for an arena
+ */
+static void G_ArenaDoWork(arena_t *a, uint32_t work) {
+    if (work & ARENA_WORK_STATUS) {
+        G_UpdateConfigStrings(a);
+    }
+    if (work & ARENA_WORK_STATUSBARS) {
+        G_UpdatePlayerStatusBars(a);
+    }
+    if (work & ARENA_WORK_SCORES) {
+        G_ShowScores(a);
+    }
+}
+
+/**
+ * Queue up non time-critical work for an arena. It gets done at the end of
+ * this frame or a few frames later, depending on how busy the server is.
+ * Gameplay state changes should never go through here.
+ */
+void G_ArenaQueueWork(arena_t *a, uint32_t work) {
+    if (!a) {
+        return;
+    }
+
+    // scheduler disabled, do it right now
+    if ((int)g_arena_budget->value <= 0) {
+        G_ArenaDoWork(a, work);
+        return;
+    }
+
+    if (!a->work) {
+        a->work_frame = level.framenum;
+    }
+    a->work |= work;
+}
+
+/**
+ * Run queued arena work, called once per frame after all arenas think.
+ *
+ * Each arena's work costs one message per client in it. Arenas are visited
+ * round-robin and skipped once g_arena_budget messages have been sent this
+ * frame, so arenas that all transition together get spread across a few
+ * frames. Work is never held more than ARENA_WORK_MAXDELAY frames.
+ */
+void G_RunArenaWork(void) {
+    static int  start;
+    int         i, spent, cost, budget;
+    uint32_t    work;
+    arena_t     *a;
+
+    budget = (int)g_arena_budget->value;
+    spent = 0;
+
+    for (i = 0; i < MAX_ARENAS; i++) {
+        a = &level.arenas[(start + i) % MAX_ARENAS];
+        if (!a->work) {
+            continue;
+        }
+
+        cost = a->client_count;
+        if (spent && spent + cost > budget &&
+                level.framenum - a->work_frame < ARENA_WORK_MAXDELAY) {
+            continue;
+        }
+
+        work = a->work;
+        a->work = 0;
+        G_ArenaDoWork(a, work);
+        spent += cost;
+    }
+
+    start = (start + 1) % MAX_ARENAS;
+}
+
 /**
  * Stuff that needs to be reset between rounds
  */
@@ -412,6 +488,8 @@ void G_ClearRoundInfo(arena_t *a) {
         a->teams[i].damage_dealt = 0;
         a->teams[i].damage_taken = 0;
     }
+    G_FoldRoundStats(a);
+    G_ClearArenaStats(a);
     a->teams_alive = a->team_count;
 }
 
@@ -495,6 +573,20 @@ void G_BuildMenu(void) {
     }
 }
 
+/**
+ * Accuracy formatted with fmt, or nothing before the first attempt
+ */
+static const char *G_AccuracyString(const playerstats_t *s, const char *fmt) {
+    static char buffer[16];
+    int acc = G_StatsAccuracy(s);
+
+    if (acc < 0) {
+        return "";
+    }
+    Q_snprintf(buffer, sizeof(buffer), fmt, acc);
+    return buffer;
+}
+
 /**
  * Used to update per-client scoreboard and build
  * global oldscores (client is NULL in the latter case).
@@ -510,8 +602,9 @@ size_t G_BuildScoreboard(char *buffer, gclient_t *client, arena_t *arena) {
     int y, sec;
     gclient_t *ranks[MAX_CLIENTS];
     gclient_t *c;
+    playerstats_t stats;
     time_t t;
-    struct tm *tm;
+    struct tm tm;
     edict_t *ent;
 
     if (!buffer) {
@@ -528,8 +621,10 @@ size_t G_BuildScoreboard(char *buffer, gclient_t *client, arena_t *arena) {
 
     // Build time string
     t = time(NULL);
-    tm = localtime(&t);
-    len = strftime(status, sizeof(status), DATE_FORMAT, tm);
+    len = 0;
+    if (os_localtime(&t, &tm)) {
+        len = strftime(status, sizeof(status), DATE_FORMAT, &tm);
+    }
 
     if (len < 1) {
         strcpy(status, "???");
@@ -548,13 +643,15 @@ size_t G_BuildScoreboard(char *buffer, gclient_t *client, arena_t *arena) {
 
     total = 0;
     for (k=0; k<arena->team_count; k++) {
+        G_TeamStats(arena, &arena->teams[k], &stats);
         total += Q_scnprintf(buffer + total, MAX_STRING_CHARS, "xv 0 %s "
                 "yt %d "
-                "cstring \"Team %s - %d\" "
+                "cstring \"Team %s - %d%s\" "
                 "yt %d "
-                "cstring2 \"Name                 Score      Time Ping\"", entry, y,
+                "cstring2 \"Name                 Score  Acc Time Ping\"", entry, y,
                 arena->teams[k].name,
                 arena->teams[k].points,
+                G_AccuracyString(&stats, " (%d%%)"),
                 y + LAYOUT_LINE_HEIGHT
         );
 
@@ -581,10 +678,12 @@ size_t G_BuildScoreboard(char *buffer, gclient_t *client, arena_t *arena) {
                 sprintf(timebuf, "%d", sec / 60);
             }
 
+            G_ClientStats(c, &stats);
             len = Q_snprintf(entry, sizeof(entry),
-                    "yt %d cstring \"%-21s %6d     %4s %4d\"", y,
+                    "yt %d cstring \"%-21s %6d %4s %4s %4d\"", y,
                     c->pers.netname,
                     c->pers.score,
+                    G_AccuracyString(&stats, "%d%%"),
                     timebuf,
                     c->ping
             );
@@ -635,8 +734,8 @@ size_t G_BuildScoreboard(char *buffer, gclient_t *client, arena_t *arena) {
         }
 
         len = Q_snprintf(entry, sizeof(entry),
-                "yt %d cstring \"%s\"", y,
-                va("%s:%d %s", NAME(ent), ent->client->ping, status));
+                "yt %d cstring \"%s:%d %s\"", y,
+                NAME(ent), ent->client->ping, status);
 
         if (len >= sizeof(entry)) {
             continue;
@@ -681,7 +780,7 @@ size_t G_BuildPregameScoreboard(char *buffer, gclient_t *client, arena_t *arena)
     gclient_t *ranks[MAX_CLIENTS];
     gclient_t *c;
     time_t t;
-    struct tm *tm;
+    struct tm tm;
     edict_t *ent;
 
     if (!buffer) {
@@ -695,16 +794,20 @@ size_t G_BuildPregameScoreboard(char *buffer, gclient_t *client, arena_t *arena)
 
     char bracketopen[2];
     char bracketclosed[2];
+    char readytag[16];
     G_AsciiToConsole(bracketopen, "[");
     G_AsciiToConsole(bracketclosed, "]");
+    Q_snprintf(readytag, sizeof(readytag), "%sready%s", bracketopen, bracketclosed);
     
     // starting point down from top of screen
     y = 20;
 
     // Build time string
     t = time(NULL);
-    tm = localtime(&t);
-    len = strftime(status, sizeof(status), DATE_FORMAT, tm);
+    len = 0;
+    if (os_localtime(&t, &tm)) {
+        len = strftime(status, sizeof(status), DATE_FORMAT, &tm);
+    }
 
     if (len < 1) {
         strcpy(status, "???");
@@ -759,7 +862,7 @@ size_t G_BuildPregameScoreboard(char *buffer, gclient_t *client, arena_t *arena)
 
             len = Q_snprintf(entry, sizeof(entry),
                     "yt %d cstring \"%-15s %-15s %4s %4d\"", y, c->pers.netname,
-                    (c->pers.ready) ? va("%sready%s", bracketopen, bracketclosed) : "",
+                    (c->pers.ready) ? readytag : "",
                     timebuf, c->ping);
 
             if (len >= sizeof(entry)) {
@@ -808,8 +911,8 @@ size_t G_BuildPregameScoreboard(char *buffer, gclient_t *client, arena_t *arena)
         }
 
         len = Q_snprintf(entry, sizeof(entry),
-                "yt %d cstring \"%s\"", y,
-                va("%s:%d %s", NAME(ent), ent->client->ping, status));
+                "yt %d cstring \"%s:%d %s\"", y,
+                NAME(ent), ent->client->ping, status);
 
         if (len >= sizeof(entry)) {
             continue;
@@ -845,11 +948,12 @@ size_t G_BuildPregameScoreboard(char *buffer, gclient_t *client, arena_t *arena)
  * Show all players connected.
  */
 size_t G_BuildPlayerboard(char *buffer, arena_t *arena) {
-    char entry[MAX_STRING_CHARS], status[MAX_QPATH];
+    char entry[MAX_STRING_CHARS], status[MAX_QPATH], arenaname[MAX_QPATH];
     size_t total, len;
     int i, y;
     gclient_t *c;
     time_t t;
+    struct tm tm;
     arena_t *a;
 
     if (!buffer) {
@@ -866,7 +970,10 @@ size_t G_BuildPlayerboard(char *buffer, arena_t *arena) {
 
     // Build time string
     t = time(NULL);
-    len = strftime(status, sizeof(status), DATE_FORMAT, (struct tm *) localtime(&t));
+    len = 0;
+    if (os_localtime(&t, &tm)) {
+        len = strftime(status, sizeof(status), DATE_FORMAT, &tm);
+    }
 
     if (len < 1) {
         strcpy(status, "Beer O'Clock");
@@ -895,10 +1002,11 @@ size_t G_BuildPlayerboard(char *buffer, arena_t *arena) {
         }
 
         a = c->pers.arena;
+        Q_snprintf(arenaname, sizeof(arenaname), "%d:%s", a->number, a->name);
 
         len = Q_snprintf(entry, sizeof(entry),
                 "yt %d cstring \"%-15s %-20s %4d\"", y,
-                c->pers.netname, va("%d:%s", a->number, a->name), c->ping);
+                c->pers.netname, arenaname, c->ping);
 
         if (len >= sizeof(entry)) {
             continue;
@@ -1016,6 +1124,7 @@ void G_ChangeArena(edict_t *ent, arena_t *arena) {
         ARENA(ent)->clients[index] = NULL;
         ARENA(ent)->client_count--;
         G_TeamPart(ent, true);
+        G_UpdateVoteTally(ent->client);
         if (arena) {
             for (i=0; i<ARENA(ent)->client_count; i++) {
                 if (!ARENA(ent)->clients[i]) {
@@ -1041,6 +1150,7 @@ void G_ChangeArena(edict_t *ent, arena_t *arena) {
     arena->client_count++;
     arena->clients[index] = ent;
     ARENA(ent) = arena;
+    G_UpdateVoteTally(ent->client);
     ent->client->pers.connected = CONN_SPECTATOR;
     ent->client->pers.ready = false;
     G_SpectatorsJoin(ent);
@@ -1250,6 +1360,12 @@ void G_EndMatch(arena_t *a, arena_team_t *winner) {
         }
     }
 
+    // a match cut short mid round never went through round intermission
+    if (a->state != ARENA_STATE_RINTERMISSION) {
+        G_FoldRoundStats(a);
+    }
+    G_LogMatchEnd(a, winner);
+
     // save the current scoreboard as an oldscore
     G_BuildScoreboard(a->oldscores, NULL, a);
     G_bprintf(a, PRINT_HIGH, "Match finished\n");
@@ -1348,81 +1464,12 @@ void G_GiveItems(edict_t *ent) {
     if (!ent->client) {
         return;
     }
-    
-    int flags;
-    arena_t *a;
-    a = ARENA(ent);
-    
-    // remove it all first
-    ent->client->inventory[ITEM_SHOTGUN] = 0;
-    ent->client->inventory[ITEM_SUPERSHOTGUN] = 0;
-    ent->client->inventory[ITEM_MACHINEGUN] = 0;
-    ent->client->inventory[ITEM_CHAINGUN] = 0;
-    ent->client->inventory[ITEM_GRENADELAUNCHER] = 0;
-    ent->client->inventory[ITEM_HYPERBLASTER] = 0;
-    ent->client->inventory[ITEM_ROCKETLAUNCHER] = 0;
-    ent->client->inventory[ITEM_RAILGUN] = 0;
-    ent->client->inventory[ITEM_BFG] = 0;
-    ent->client->inventory[ITEM_GRENADES] = 0;    // item & weapon
-    ent->client->inventory[ITEM_SLUGS] = 0;
-    ent->client->inventory[ITEM_ROCKETS] = 0;
-    ent->client->inventory[ITEM_CELLS] = 0;
-    ent->client->inventory[ITEM_GRENADES] = 0;
-    ent->client->inventory[ITEM_BULLETS] = 0;
-    ent->client->inventory[ITEM_SHELLS] = 0;
-
 
-    flags = a->weapon_flags;
-
-    if (flags < 2) {
-        flags = ARENAWEAPON_ALL;
-    }
-
-    // weapons and armor
-    if (flags & ARENAWEAPON_SHOTGUN) {
-        ent->client->inventory[ITEM_SHOTGUN] = 1;
-        ent->client->inventory[ITEM_SHELLS] = a->ammo[ITEM_SHELLS];
-    }
-
-    if (flags & ARENAWEAPON_SUPERSHOTGUN) {
-        ent->client->inventory[ITEM_SUPERSHOTGUN] = 1;
-        ent->client->inventory[ITEM_SHELLS] = a->ammo[ITEM_SHELLS];
-    }
-
-    if (flags & ARENAWEAPON_MACHINEGUN) {
-        ent->client->inventory[ITEM_MACHINEGUN] = 1;
-        ent->client->inventory[ITEM_BULLETS] = a->ammo[ITEM_BULLETS];
-    }
-
-    if (flags & ARENAWEAPON_CHAINGUN) {
-        ent->client->inventory[ITEM_CHAINGUN] = 1;
-        ent->client->inventory[ITEM_BULLETS] = a->ammo[ITEM_BULLETS];
-    }
-
-    if (flags & ARENAWEAPON_GRENADELAUNCHER) {
-        ent->client->inventory[ITEM_GRENADELAUNCHER] = 1;
-        ent->client->inventory[ITEM_GRENADES] = a->ammo[ITEM_GRENADES];
-    }
-
-    if (flags & ARENAWEAPON_HYPERBLASTER) {
-        ent->client->inventory[ITEM_HYPERBLASTER] = 1;
-        ent->client->inventory[ITEM_CELLS] = a->ammo[ITEM_CELLS];
-    }
-
-    if (flags & ARENAWEAPON_ROCKETLAUNCHER) {
-        ent->client->inventory[ITEM_ROCKETLAUNCHER] = 1;
-        ent->client->inventory[ITEM_ROCKETS] = a->ammo[ITEM_ROCKETS];
-    }
-
-    if (flags & ARENAWEAPON_RAILGUN) {
-        ent->client->inventory[ITEM_RAILGUN] = 1;
-        ent->client->inventory[ITEM_SLUGS] = a->ammo[ITEM_SLUGS];
-    }
+    arena_t *a = ARENA(ent);
 
-    if (flags & ARENAWEAPON_BFG) {
-        ent->client->inventory[ITEM_BFG] = 1;
-        ent->client->inventory[ITEM_CELLS] = a->ammo[ITEM_CELLS];
-    }
+    // weapons and ammo are contiguous from the shotgun to slugs
+    memcpy(&ent->client->inventory[ITEM_SHOTGUN], &a->loadout.spawn[ITEM_SHOTGUN],
+            (ITEM_SLUGS - ITEM_SHOTGUN + 1) * sizeof(int));
 
     ent->client->inventory[ITEM_ARMOR_BODY] = a->armor;
     ent->health = a->health;
@@ -1482,11 +1529,13 @@ void G_TeamJoin(edict_t *ent, arena_team_type_t type, qboolean forced) {
     // add player to the team
     TEAM(ent) = team;
     team->player_count++;
+    G_UpdateVoteTally(ent->client);
 
     int i;
     for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
         if (!team->players[i]) {    // free player slot, take it
             team->players[i] = ent;
+            memset(G_PlayerStats(ent), 0, sizeof(playerstats_t));
             break;
         }
     }
@@ -1524,6 +1573,9 @@ void G_TeamPart(edict_t *ent, qboolean silent) {
         return;
     }
 
+    // keep this round's counters before the slot is given up
+    G_FoldPlayerStats(ent);
+
     // remove player
     for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
         if (oldteam->players[i] == ent) {
@@ -1551,6 +1603,7 @@ void G_TeamPart(edict_t *ent, qboolean silent) {
 
     ent->client->pers.ready = false;
     ent->client->pers.team = 0;
+    G_UpdateVoteTally(ent->client);
 
     G_SpectatorsJoin(ent);
     G_CheckTeamReady(oldteam);
@@ -1567,12 +1620,9 @@ void G_RefillInventory(edict_t *ent) {
     }
     arena_t *a = ARENA(ent);
 
-    ent->client->inventory[ITEM_SLUGS]    = a->ammo[ITEM_SLUGS];
-    ent->client->inventory[ITEM_ROCKETS]  = a->ammo[ITEM_ROCKETS];
-    ent->client->inventory[ITEM_CELLS]    = a->ammo[ITEM_CELLS];
-    ent->client->inventory[ITEM_GRENADES] = a->ammo[ITEM_GRENADES];
-    ent->client->inventory[ITEM_BULLETS]  = a->ammo[ITEM_BULLETS];
-    ent->client->inventory[ITEM_SHELLS]   = a->ammo[ITEM_SHELLS];
+    memcpy(&ent->client->inventory[ITEM_SHELLS], &a->loadout.refill[ITEM_SHELLS],
+            (ITEM_SLUGS - ITEM_SHELLS + 1) * sizeof(int));
+    ent->client->inventory[ITEM_GRENADES] = a->loadout.refill[ITEM_GRENADES];
     ent->client->inventory[ITEM_ARMOR_BODY] = a->armor;
     ent->health = a->health;
 }
@@ -1621,13 +1671,20 @@ void G_RespawnPlayers(arena_t *a) {
  * Format a string saying what round we're on
  */
 char *G_RoundToString(arena_t *a) {
-    static char round_buffer[14];
+    return G_RoundToString_r(a, Q_ScratchBuffer(), MAX_STRING_CHARS);
+}
+
+/**
+ * Same as G_RoundToString() but written into a caller supplied buffer
+ */
+char *G_RoundToString_r(arena_t *a, char *out, size_t size) {
+    out[0] = 0;
     if (!a) {
         gi.dprintf("%s(): null arena\n", __func__);
-        return round_buffer;
+        return out;
     }
-    sprintf(round_buffer, "Round %02d/%02d", a->current_round, a->round_limit);
-    return round_buffer;
+    Q_snprintf(out, size, "Round %02d/%02d", a->current_round, a->round_limit);
+    return out;
 }
 
 /**
@@ -1664,6 +1721,7 @@ void G_HideScores(arena_t *a) {
         gi.dprintf("%s(): null arena\n", __func__);
         return;
     }
+    a->work &= ~ARENA_WORK_SCORES;
     // for each team
     for (i = 0; i < a->team_count; i++) {
         // for each player
@@ -1724,6 +1782,7 @@ void G_StartRound(arena_t *a) {
 
     a->state = ARENA_STATE_PLAY;
     a->round_start_frame = a->round_frame - SECS_TO_FRAMES(1);
+    G_LogRoundStart(a);
 
     G_Centerprintf(a, "Fight!");
     G_ArenaSound(a, level.sounds.secret);
@@ -1820,6 +1879,7 @@ void G_MergeArenaSettings(arena_t *a, arena_entry_t *m) {
         a->mode = ARENA_MODE_NORMAL;
         a->corpseview = qfalse;
         memset(&a->infinite, 0, sizeof(a->infinite));
+        G_BuildLoadout(a);
         return;
     }
 
@@ -1916,6 +1976,7 @@ void G_MergeArenaSettings(arena_t *a, arena_entry_t *m) {
     a->original_weapon_flags = a->weapon_flags;
 
     a->modified = false;
+    G_BuildLoadout(a);
 }
 
 /**
@@ -1955,14 +2016,32 @@ qboolean G_Arenamates(edict_t *p1, edict_t *p2) {
 }
 
 /**
- * Read in the per-arena map config file and fill in the arena_entry structure
+ * Parsed mapcfg files, kept for the life of the game so map rotations don't
+ * reread them. An entry is reused while the file's mtime and size match.
+ */
+typedef struct {
+    list_t          entry;
+    qboolean        exists;
+    time_t          mtime;
+    off_t           size;
+    int             fastswitch; // g_fast_weapon_change at parse time
+    size_t          count;
+    arena_entry_t   arenas[MAX_ARENAS];
+    char            path[1];
+} mapcfg_t;
+
+static LIST_DECL(mapcfg_cache);
+
+mapcfg_stats_t mapcfg_stats;
+
+/**
+ * Read in the per-arena map config file at path and fill in the arena_entry
+ * structure
  *
  * return the number of arenas found in the file.
  */
-size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
-    size_t len;
+static size_t G_ReadMapSettings(arena_entry_t *entry, const char *path) {
     int count;
-    char path[MAX_OSPATH];
     char buffer[MAX_STRING_CHARS];
     FILE *fp;
     int arena_num;
@@ -1972,20 +2051,12 @@ size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
     temp_weaponflags_t twf;
 
     count = 0;
-    if (!entry) {
-        gi.dprintf("%s(): null arena_entry_t\n", __func__);
-        return count;
-    }
-    len = Q_concat(path, sizeof(path), game.dir, "/mapcfg/", mapname, ".cfg", NULL);
-
-    if (len == 0) {
-        return 0;
-    }
-
     fp = fopen(path, "r");
 
     if (fp) {
         arena_num = -1;
+        inarena = qfalse;
+        mapcfg_stats.reads++;
 
         while (qtrue) {
             fp_data = fgets(buffer, sizeof(buffer), fp);
@@ -2012,7 +2083,7 @@ size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
 
             if (Q_strcasecmp(token, "arena") == 0 && inarena) {
                 arena_num = atoi(COM_Parse(&fp_data));
-                if (arena_num >= MAX_ARENAS) {
+                if (arena_num < 0 || arena_num >= MAX_ARENAS) {
                     continue;
                 }
 
@@ -2022,6 +2093,10 @@ size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
                 entry[arena_num].fastswitch = (int) g_fast_weapon_change->value;
             }
 
+            if (arena_num < 0 || arena_num >= MAX_ARENAS) {
+                continue;
+            }
+
             if (Q_strcasecmp(token, "teams") == 0 && inarena) {
                 entry[arena_num].teams = atoi(COM_Parse(&fp_data));
             }
@@ -2095,6 +2170,112 @@ size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
     return count;
 }
 
+/**
+ * Parse the mapcfg at path into cfg, or copy it out of the binary config
+ * snapshot if that was made from the same version of the file.
+ */
+static void G_LoadMapSettings(mapcfg_t *cfg, const char *path) {
+    const byte *data;
+    int32_t head[2];    // arena count, fastswitch default
+    byte buffer[sizeof(head) + sizeof(cfg->arenas)];
+    size_t len;
+
+    data = G_CacheFind(CACHE_MAPCFG, path, &len);
+    if (data && len == sizeof(buffer)) {
+        memcpy(head, data, sizeof(head));
+
+        // the default is baked into the entries, other servers may differ
+        if (head[1] == cfg->fastswitch) {
+            cfg->count = head[0];
+            memcpy(cfg->arenas, data + sizeof(head), sizeof(cfg->arenas));
+            return;
+        }
+    }
+
+    cfg->count = G_ReadMapSettings(cfg->arenas, path);
+
+    head[0] = cfg->count;
+    head[1] = cfg->fastswitch;
+    memcpy(buffer, head, sizeof(head));
+    memcpy(buffer + sizeof(head), cfg->arenas, sizeof(cfg->arenas));
+    G_CacheStore(CACHE_MAPCFG, path, buffer, sizeof(buffer));
+}
+
+/**
+ * Fill in the arena_entry structure from mapcfg/<mapname>.cfg, using the
+ * cached copy when the file hasn't changed since it was last parsed.
+ *
+ * return the number of arenas found in the file.
+ */
+size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname) {
+    char path[MAX_OSPATH];
+    Q_STATBUF st;
+    qboolean exists;
+    mapcfg_t *cfg;
+    size_t len;
+
+    if (!entry) {
+        gi.dprintf("%s(): null arena_entry_t\n", __func__);
+        return 0;
+    }
+    len = Q_concat(path, sizeof(path), game.dir, "/mapcfg/", mapname, ".cfg", NULL);
+
+    if (len == 0 || len >= sizeof(path)) {
+        return 0;
+    }
+
+    exists = os_stat(path, &st) == 0;
+
+    LIST_FOR_EACH(mapcfg_t, cfg, &mapcfg_cache, entry) {
+        if (strcmp(cfg->path, path)) {
+            continue;
+        }
+        if (cfg->exists == exists &&
+                (!exists || (cfg->mtime == st.st_mtime && cfg->size == st.st_size)) &&
+                cfg->fastswitch == (int) g_fast_weapon_change->value) {
+            mapcfg_stats.hits++;
+            memcpy(entry, cfg->arenas, sizeof(cfg->arenas));
+            return cfg->count;
+        }
+
+        // stale, parse it again below
+        List_Remove(&cfg->entry);
+        gi.TagFree(cfg);
+        mapcfg_stats.cached--;
+        break;
+    }
+
+    mapcfg_stats.misses++;
+    cfg = G_Malloc(sizeof(*cfg) + len);
+    memset(cfg, 0, sizeof(*cfg));
+    memcpy(cfg->path, path, len + 1);
+    cfg->exists = exists;
+    cfg->fastswitch = (int) g_fast_weapon_change->value;
+    if (exists) {
+        cfg->mtime = st.st_mtime;
+        cfg->size = st.st_size;
+        G_LoadMapSettings(cfg, path);
+    }
+    List_Append(&mapcfg_cache, &cfg->entry);
+    mapcfg_stats.cached++;
+
+    memcpy(entry, cfg->arenas, sizeof(cfg->arenas));
+    return cfg->count;
+}
+
+/**
+ * Drop every cached mapcfg so the next map load rereads them from disk
+ */
+void G_FlushMapSettings(void) {
+    mapcfg_t *cfg, *next;
+
+    LIST_FOR_EACH_SAFE(mapcfg_t, cfg, next, &mapcfg_cache, entry) {
+        gi.TagFree(cfg);
+    }
+    List_Init(&mapcfg_cache);
+    mapcfg_stats.cached = 0;
+}
+
 /**
  * Set the best weapon available as current
  */
@@ -2159,6 +2340,7 @@ void G_ResetTeam(arena_team_t *t) {
 
             memset(&player->client->resp, 0, sizeof(player->client->resp));
             memset(&player->client->level.vote, 0, sizeof(player->client->level.vote));
+            G_UpdateVoteTally(player->client);
 
             player->movetype = MOVETYPE_NOCLIP; // don't leave a body
             player->client->pers.ready = qfalse;
@@ -2223,7 +2405,7 @@ void G_ResetArena(arena_t *a) {
     a->current_round = 1;
 
     G_ConfigString(a, CS_ROUND, G_RoundToString(a));
-    G_UpdateConfigStrings(a);
+    G_ArenaQueueWork(a, ARENA_WORK_STATUS);
 
     for (i=0; i<a->team_count; i++) {
         G_ResetTeam(&a->teams[i]);
@@ -2250,6 +2432,166 @@ void G_ArenaCast(arena_t *a, qboolean reliable) {
 }
 
 
+/**
+ * Effect messages bound for G_ArenaMulticast() are recorded here first, the
+ * server clears its own buffer after every unicast so it can't be reused.
+ */
+typedef enum {
+    MSG_BYTE,
+    MSG_SHORT,
+    MSG_POSITION,
+    MSG_DIR
+} msg_op_t;
+
+static struct {
+    int         count;
+    size_t      bytes;
+    struct {
+        msg_op_t    op;
+        int         value;
+        vec3_t      vec;
+    } ops[16];
+} arena_msg;
+
+/**
+ *
+ */
+static void G_RecordMsg(msg_op_t op, int value, const vec3_t vec, size_t bytes) {
+    if (arena_msg.count == q_countof(arena_msg.ops)) {
+        gi.dprintf("%s(): message overflow\n", __func__);
+        return;
+    }
+    arena_msg.ops[arena_msg.count].op = op;
+    arena_msg.ops[arena_msg.count].value = value;
+    if (vec) {
+        VectorCopy(vec, arena_msg.ops[arena_msg.count].vec);
+    }
+    arena_msg.count++;
+    arena_msg.bytes += bytes;
+}
+
+void G_WriteByte(int c) {
+    G_RecordMsg(MSG_BYTE, c, NULL, 1);
+}
+
+void G_WriteShort(int c) {
+    G_RecordMsg(MSG_SHORT, c, NULL, 2);
+}
+
+void G_WritePosition(vec3_t pos) {
+    G_RecordMsg(MSG_POSITION, 0, pos, 6);
+}
+
+void G_WriteDir(vec3_t dir) {
+    G_RecordMsg(MSG_DIR, 0, dir, 1);
+}
+
+/**
+ * Copy the recorded message into the server's message buffer
+ */
+static void G_ReplayMsg(void) {
+    int i;
+
+    for (i = 0; i < arena_msg.count; i++) {
+        switch (arena_msg.ops[i].op) {
+        case MSG_BYTE:
+            gi.WriteByte(arena_msg.ops[i].value);
+            break;
+        case MSG_SHORT:
+            gi.WriteShort(arena_msg.ops[i].value);
+            break;
+        case MSG_POSITION:
+            gi.WritePosition(arena_msg.ops[i].vec);
+            break;
+        case MSG_DIR:
+            gi.WriteDir(arena_msg.ops[i].vec);
+            break;
+        }
+    }
+}
+
+/**
+ * The arena an entity's effects belong to: a player's own arena, the owner's
+ * arena for projectiles, or the arena number set on map entities
+ */
+arena_t *G_EdictArena(edict_t *ent) {
+    if (!ent) {
+        return NULL;
+    }
+    if (ent->client) {
+        return ent->client->pers.arena;
+    }
+    if (ent->owner && ent->owner->client) {
+        return ent->owner->client->pers.arena;
+    }
+    if (ent->arena > 0 && ent->arena < MAX_ARENAS && level.arenas[ent->arena].number) {
+        return &level.arenas[ent->arena];
+    }
+    return NULL;
+}
+
+/**
+ * Send the message recorded with G_Write*() like gi.multicast() would, but
+ * only to clients in arena a (players, spectators and chasers) and mvd
+ * spectators. Clients outside the PVS/PHS of origin are still skipped. A NULL
+ * arena falls back to a normal multicast.
+ *
+ * Copies sent to mvd spectators are not counted in a->multicast.sends and
+ * a->multicast.bytes, so 'sv multicast' and the metrics dump only show what
+ * went to the arena's own clients.
+ */
+void G_ArenaMulticast(vec3_t origin, multicast_t to, arena_t *a) {
+    qboolean reliable;
+    gclient_t *cl;
+    edict_t *ent;
+    int i;
+
+    if (!a) {
+        G_ReplayMsg();
+        gi.multicast(origin, to);
+        goto done;
+    }
+
+    reliable = to == MULTICAST_ALL_R || to == MULTICAST_PHS_R || to == MULTICAST_PVS_R;
+
+    a->multicast.messages++;
+    for (i = 0; i < game.maxclients; i++) {
+        cl = &game.clients[i];
+        ent = cl->edict;
+        if (!ent || !ent->inuse) {
+            continue;
+        }
+
+        // mvd spectators see every arena
+        if (cl->pers.mvdspec) {
+            G_ReplayMsg();
+            gi.unicast(ent, reliable);
+            continue;
+        }
+
+        if (cl->pers.arena != a) {
+            continue;
+        }
+        if (cl->pers.connected != CONN_SPAWNED && cl->pers.connected != CONN_SPECTATOR) {
+            continue;
+        }
+        if ((to == MULTICAST_PHS || to == MULTICAST_PHS_R) && !gi.inPHS(origin, ent->s.origin)) {
+            continue;
+        }
+        if ((to == MULTICAST_PVS || to == MULTICAST_PVS_R) && !gi.inPVS(origin, ent->s.origin)) {
+            continue;
+        }
+        G_ReplayMsg();
+        gi.unicast(ent, reliable);
+        a->multicast.sends++;
+        a->multicast.bytes += arena_msg.bytes;
+    }
+
+done:
+    arena_msg.count = 0;
+    arena_msg.bytes = 0;
+}
+
 /**
  * Just like gi.multicast() but to every team player
  */
@@ -2270,133 +2612,227 @@ void G_TeamCast(arena_team_t *t, qboolean reliable) {
 }
 
 /**
- * Get the english version of the weapon flags
+ * Write the english version of the weapon flags into str
  */
-char *G_WeaponFlagsToString(arena_t *a) {
-    static char str[200];
-    memset(&str, 0, sizeof(str));
-    if (!a) {
-        gi.dprintf("%s(): null arena\n", __func__);
-        return str;
-    }
+static void G_BuildWeaponString(arena_t *a, char *str, size_t size) {
+    str[0] = 0;
 
     char inf[4];
     G_AsciiToConsole(inf, "inf");
 
     if (a->weapon_flags & ARENAWEAPON_SHOTGUN) {
         if (a->infinite[ITEM_SHELLS]) {
-            strcat(str, va("sg:%s, ", inf));
+            Q_strlcat(str, va("sg:%s, ", inf), size);
         } else {
-            strcat(str, va("sg:%d, ", a->ammo[ITEM_SHELLS]));
+            Q_strlcat(str, va("sg:%d, ", a->ammo[ITEM_SHELLS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_SUPERSHOTGUN) {
         if (a->infinite[ITEM_SHELLS]) {
-            strcat(str, va("ssg:%s, ", inf));
+            Q_strlcat(str, va("ssg:%s, ", inf), size);
         } else {
-            strcat(str, va("ssg:%d, ", a->ammo[ITEM_SHELLS]));
+            Q_strlcat(str, va("ssg:%d, ", a->ammo[ITEM_SHELLS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_MACHINEGUN) {
         if (a->infinite[ITEM_BULLETS]) {
-            strcat(str, va("mg:%s, ", inf));
+            Q_strlcat(str, va("mg:%s, ", inf), size);
         } else {
-            strcat(str, va("mg:%d, ", a->ammo[ITEM_BULLETS]));
+            Q_strlcat(str, va("mg:%d, ", a->ammo[ITEM_BULLETS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_CHAINGUN) {
         if (a->infinite[ITEM_BULLETS]) {
-            strcat(str, va("cg:%s, ", inf));
+            Q_strlcat(str, va("cg:%s, ", inf), size);
         } else {
-            strcat(str, va("cg:%d, ", a->ammo[ITEM_BULLETS]));
+            Q_strlcat(str, va("cg:%d, ", a->ammo[ITEM_BULLETS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_GRENADE) {
         if (a->infinite[ITEM_GRENADES]) {
-            strcat(str, va("gr:%s, ", inf));
+            Q_strlcat(str, va("gr:%s, ", inf), size);
         } else {
-            strcat(str, va("gr:%d, ", a->ammo[ITEM_GRENADES]));
+            Q_strlcat(str, va("gr:%d, ", a->ammo[ITEM_GRENADES]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_GRENADELAUNCHER) {
         if (a->infinite[ITEM_GRENADES]) {
-            strcat(str, va("gl:%s, ", inf));
+            Q_strlcat(str, va("gl:%s, ", inf), size);
         } else {
-            strcat(str, va("gl:%d, ", a->ammo[ITEM_GRENADES]));
+            Q_strlcat(str, va("gl:%d, ", a->ammo[ITEM_GRENADES]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_HYPERBLASTER) {
         if (a->infinite[ITEM_CELLS]) {
-            strcat(str, va("hb:%s, ", inf));
+            Q_strlcat(str, va("hb:%s, ", inf), size);
         } else {
-            strcat(str, va("hb:%d, ", a->ammo[ITEM_CELLS]));
+            Q_strlcat(str, va("hb:%d, ", a->ammo[ITEM_CELLS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_ROCKETLAUNCHER) {
         if (a->infinite[ITEM_ROCKETS]) {
-            strcat(str, va("rl:%s, ", inf));
+            Q_strlcat(str, va("rl:%s, ", inf), size);
         } else {
-            strcat(str, va("rl:%d, ", a->ammo[ITEM_ROCKETS]));
+            Q_strlcat(str, va("rl:%d, ", a->ammo[ITEM_ROCKETS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_RAILGUN) {
         if (a->infinite[ITEM_SLUGS]) {
-            strcat(str, va("rg:%s, ", inf));
+            Q_strlcat(str, va("rg:%s, ", inf), size);
         } else {
-            strcat(str, va("rg:%d, ", a->ammo[ITEM_SLUGS]));
+            Q_strlcat(str, va("rg:%d, ", a->ammo[ITEM_SLUGS]), size);
         }
     }
 
     if (a->weapon_flags & ARENAWEAPON_BFG) {
         if (a->infinite[ITEM_CELLS]) {
-            strcat(str, va("bfg:%s, ", inf));
+            Q_strlcat(str, va("bfg:%s, ", inf), size);
         } else {
-            strcat(str, va("bfg:%d, ", a->ammo[ITEM_CELLS]));
+            Q_strlcat(str, va("bfg:%d, ", a->ammo[ITEM_CELLS]), size);
         }
     }
 
-    str[strlen(str) -2] = 0;
-    return str;
+    if (str[0]) {
+        str[strlen(str) - 2] = 0;
+    }
+}
+
+/**
+ * Get the english version of the weapon flags
+ */
+char *G_WeaponFlagsToString(arena_t *a) {
+    static char none[1];
+    if (!a) {
+        gi.dprintf("%s(): null arena\n", __func__);
+        return none;
+    }
+    return a->loadout.weapons;
+}
+
+/**
+ * Resolve the arena's weapon flags and ammo settings into the inventory
+ * templates used by G_GiveItems() and G_RefillInventory(). Needs to be
+ * called any time weapon_flags, damage_flags, ammo or infinite change.
+ */
+void G_BuildLoadout(arena_t *a) {
+    arena_loadout_t *l;
+    int flags;
+
+    if (!a) {
+        gi.dprintf("%s(): null arena\n", __func__);
+        return;
+    }
+
+    l = &a->loadout;
+    memset(l->spawn, 0, sizeof(l->spawn));
+    memset(l->refill, 0, sizeof(l->refill));
+
+    flags = a->weapon_flags;
+    if (flags < 2) {
+        flags = ARENAWEAPON_ALL;
+    }
+
+    if (flags & ARENAWEAPON_SHOTGUN) {
+        l->spawn[ITEM_SHOTGUN] = 1;
+        l->spawn[ITEM_SHELLS] = a->ammo[ITEM_SHELLS];
+    }
+
+    if (flags & ARENAWEAPON_SUPERSHOTGUN) {
+        l->spawn[ITEM_SUPERSHOTGUN] = 1;
+        l->spawn[ITEM_SHELLS] = a->ammo[ITEM_SHELLS];
+    }
+
+    if (flags & ARENAWEAPON_MACHINEGUN) {
+        l->spawn[ITEM_MACHINEGUN] = 1;
+        l->spawn[ITEM_BULLETS] = a->ammo[ITEM_BULLETS];
+    }
+
+    if (flags & ARENAWEAPON_CHAINGUN) {
+        l->spawn[ITEM_CHAINGUN] = 1;
+        l->spawn[ITEM_BULLETS] = a->ammo[ITEM_BULLETS];
+    }
+
+    if (flags & ARENAWEAPON_GRENADELAUNCHER) {
+        l->spawn[ITEM_GRENADELAUNCHER] = 1;
+        l->spawn[ITEM_GRENADES] = a->ammo[ITEM_GRENADES];
+    }
+
+    if (flags & ARENAWEAPON_HYPERBLASTER) {
+        l->spawn[ITEM_HYPERBLASTER] = 1;
+        l->spawn[ITEM_CELLS] = a->ammo[ITEM_CELLS];
+    }
+
+    if (flags & ARENAWEAPON_ROCKETLAUNCHER) {
+        l->spawn[ITEM_ROCKETLAUNCHER] = 1;
+        l->spawn[ITEM_ROCKETS] = a->ammo[ITEM_ROCKETS];
+    }
+
+    if (flags & ARENAWEAPON_RAILGUN) {
+        l->spawn[ITEM_RAILGUN] = 1;
+        l->spawn[ITEM_SLUGS] = a->ammo[ITEM_SLUGS];
+    }
+
+    if (flags & ARENAWEAPON_BFG) {
+        l->spawn[ITEM_BFG] = 1;
+        l->spawn[ITEM_CELLS] = a->ammo[ITEM_CELLS];
+    }
+
+    // round refills hand back every ammo type regardless of weapons
+    l->refill[ITEM_SHELLS] = a->ammo[ITEM_SHELLS];
+    l->refill[ITEM_BULLETS] = a->ammo[ITEM_BULLETS];
+    l->refill[ITEM_GRENADES] = a->ammo[ITEM_GRENADES];
+    l->refill[ITEM_CELLS] = a->ammo[ITEM_CELLS];
+    l->refill[ITEM_ROCKETS] = a->ammo[ITEM_ROCKETS];
+    l->refill[ITEM_SLUGS] = a->ammo[ITEM_SLUGS];
+
+    G_BuildWeaponString(a, l->weapons, sizeof(l->weapons));
+    G_DamageFlagsToString_r(a->damage_flags, l->damage, sizeof(l->damage));
 }
 
 /**
  * Get the english version of damage flags
  */
 char *G_DamageFlagsToString(uint32_t df) {
-    static char str[200];
+    return G_DamageFlagsToString_r(df, Q_ScratchBuffer(), MAX_STRING_CHARS);
+}
 
-    memset(&str, 0, sizeof(str));
+/**
+ * Same as G_DamageFlagsToString() but written into a caller supplied buffer
+ */
+char *G_DamageFlagsToString_r(uint32_t df, char *str, size_t size) {
+    str[0] = 0;
 
     if (df == 0) {
-        return "none";
+        Q_strlcpy(str, "none", size);
+        return str;
     }
 
     if (df & ARENADAMAGE_SELF) {
-        strcat(str, "self health, ");
+        Q_strlcat(str, "self health, ", size);
     }
 
     if (df & ARENADAMAGE_SELF_ARMOR) {
-        strcat(str, "self armor, ");
+        Q_strlcat(str, "self armor, ", size);
     }
 
     if (df & ARENADAMAGE_TEAM) {
-        strcat(str, "team health, ");
+        Q_strlcat(str, "team health, ", size);
     }
 
     if (df & ARENADAMAGE_TEAM_ARMOR) {
-        strcat(str, "team armor, ");
+        Q_strlcat(str, "team armor, ", size);
     }
 
     if (df & ARENADAMAGE_FALL) {
-        strcat(str, "falling, ");
+        Q_strlcat(str, "falling, ", size);
     }
 
     if (strlen(str) > 1) {
@@ -2425,102 +2861,96 @@ void G_RandomizeAmmo(uint16_t *out) {
     out[ITEM_SLUGS]    = genrand_int32() & 0xF;
 }
 
+// weapon icons and ammo counts appended to the player statusbar
+typedef struct {
+    char    weapon[175];        // the weapon icons
+    char    ammo[135];          // the ammo counts
+    size_t  weaponlen, ammolen;
+    int     y;
+} statusbar_hud_t;
+
 /**
- * Generate a player-specific statusbar
+ * Append one weapon icon and its ammo count to the weapon hud
  */
-const char *G_CreatePlayerStatusBar(edict_t *player) {
-    static char *statusbar;
-    static char weaponhud[175];        // the weapon icons
-    static char ammohud[135];        // the ammo counts
-    int         hud_x,
-                hud_y;
+static void G_StatusBarWeapon(statusbar_hud_t *hud, const char *pic, int stat) {
+    hud->weaponlen += Q_scnprintf(hud->weapon + hud->weaponlen,
+            sizeof(hud->weapon) - hud->weaponlen, "yv %d picn %s ", hud->y, pic);
+    hud->ammolen += Q_scnprintf(hud->ammo + hud->ammolen,
+            sizeof(hud->ammo) - hud->ammolen, "yv %d num 3 %d ", hud->y, stat);
+    hud->y += 25;
+}
+
+/**
+ * Generate a player-specific statusbar into buffer (MAX_STRING_CHARS)
+ */
+size_t G_BuildPlayerStatusBar(char *buffer, edict_t *player) {
+    statusbar_hud_t hud;
+
+    if (!buffer) {
+        return 0;
+    }
+    buffer[0] = 0;
+
     if (!player) {
         gi.dprintf("%s(): null player\n", __func__);
-        return "";
+        return 0;
     }
     if (!player->client) {
-        return "";
+        return 0;
     }
 
-    memset(weaponhud, 0, sizeof(weaponhud));
-    memset(ammohud, 0, sizeof(ammohud));
+    memset(&hud, 0, sizeof(hud));
 
     if (SHOWWEAPONHUD(player)) {
-        hud_y = 0;
-        hud_x = -25;
-
-        //weaponhud[0] = 0;
-        //ammohud[0]   = 0;
-
         // set x position at first for all weapon icons, to save the chars since CS max is 1000
-        strcpy(weaponhud, va("xr %d ", hud_x));
+        hud.weaponlen = Q_scnprintf(hud.weapon, sizeof(hud.weapon), "xr %d ", -25);
 
         // set x position for ammo quantities ^
-        strcpy(ammohud, va("xr %d ", hud_x - 50));
+        hud.ammolen = Q_scnprintf(hud.ammo, sizeof(hud.ammo), "xr %d ", -25 - 50);
 
         // super/shotgun
         if (player->client->inventory[ITEM_SUPERSHOTGUN]) {
-            strcat(weaponhud, va("yv %d picn w_sshotgun ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_SHELLS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_sshotgun", STAT_AMMO_SHELLS);
         } else if (player->client->inventory[ITEM_SHOTGUN]) {
-            strcat(weaponhud, va("yv %d picn w_shotgun ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_SHELLS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_shotgun", STAT_AMMO_SHELLS);
         }
 
         // chaingun/machinegun
         if (player->client->inventory[ITEM_CHAINGUN]) {
-            strcat(weaponhud, va("yv %d picn w_chaingun ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_BULLETS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_chaingun", STAT_AMMO_BULLETS);
         } else if (player->client->inventory[ITEM_MACHINEGUN]) {
-            strcat(weaponhud, va("yv %d picn w_machinegun ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_SHELLS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_machinegun", STAT_AMMO_SHELLS);
         }
 
         // hand grenades/launcher
         if (player->client->inventory[ITEM_GRENADELAUNCHER]) {
-            strcat(weaponhud, va("yv %d picn w_glauncher ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_GRENADES));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_glauncher", STAT_AMMO_GRENADES);
         } else if (player->client->inventory[ITEM_GRENADES]) {
-            strcat(weaponhud, va("yv %d picn w_hgrenade ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_GRENADES));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_hgrenade", STAT_AMMO_GRENADES);
         }
 
         // hyper blaster
         if (player->client->inventory[ITEM_HYPERBLASTER]) {
-            strcat(weaponhud, va("yv %d picn w_hyperblaster ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_CELLS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_hyperblaster", STAT_AMMO_CELLS);
         }
 
         // rocket launcher
         if (player->client->inventory[ITEM_ROCKETLAUNCHER]) {
-            strcat(weaponhud, va("yv %d picn w_rlauncher ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_ROCKETS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_rlauncher", STAT_AMMO_ROCKETS);
         }
 
         // railgun
         if (player->client->inventory[ITEM_RAILGUN]) {
-            strcat(weaponhud, va("yv %d picn w_railgun ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_SLUGS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_railgun", STAT_AMMO_SLUGS);
         }
 
         // BFG
         if (player->client->inventory[ITEM_BFG]) {
-            strcat(weaponhud, va("yv %d picn w_bfg ", hud_y));
-            strcat(ammohud, va("yv %d num 3 %d ", hud_y, STAT_AMMO_CELLS));
-            hud_y += 25;
+            G_StatusBarWeapon(&hud, "w_bfg", STAT_AMMO_CELLS);
         }
     }
 
-    statusbar = va(
+    return Q_scnprintf(buffer, MAX_STRING_CHARS,
         "yb -24 "
 
         // health
@@ -2621,27 +3051,28 @@ const char *G_CreatePlayerStatusBar(edict_t *player) {
         "endif "
         "%s"
         "%s",
-        weaponhud, ammohud
+        hud.weapon, hud.ammo
     );
-
-    return statusbar;
 }
 
 /**
- * Generate a spec-specific statusbar
+ * Generate a spec-specific statusbar into buffer (MAX_STRING_CHARS)
  */
-const char *G_CreateSpectatorStatusBar(edict_t *player) {
-    static char *statusbar;
+size_t G_BuildSpectatorStatusBar(char *buffer, edict_t *player) {
+    if (!buffer) {
+        return 0;
+    }
+    buffer[0] = 0;
 
     if (!player) {
         gi.dprintf("%s(): null player\n", __func__);
-        return "";
+        return 0;
     }
     if (!player->client) {
-        return "";
+        return 0;
     }
 
-    statusbar = va(
+    return Q_strlcpy(buffer,
         "yb -24 "
 
         // health
@@ -2751,31 +3182,33 @@ const char *G_CreateSpectatorStatusBar(edict_t *player) {
             "yb -35 "
             "xr -96 "
             "stat_string 28 "
-        "endif "
+        "endif ",
+        MAX_STRING_CHARS
     );
-
-    return statusbar;
 }
 
 /**
  * Send player/spec their specific statusbar
  */
 void G_SendStatusBar(edict_t *ent) {
+    char buffer[MAX_STRING_CHARS];
+
     if (!ent) {
         gi.dprintf("%s(): null edict\n", __func__);
         return;
     }
-    gi.WriteByte(SVC_CONFIGSTRING);
-    gi.WriteShort(CS_STATUSBAR);
 
     if (TEAM(ent) || ent->client->chase_target) {
-        gi.WriteString(G_CreatePlayerStatusBar(ent));
+        G_BuildPlayerStatusBar(buffer, ent);
         ent->client->pers.current_statusbar = SB_PLAYER;
     } else {
-        gi.WriteString(G_CreateSpectatorStatusBar(ent));
+        G_BuildSpectatorStatusBar(buffer, ent);
         ent->client->pers.current_statusbar = SB_SPEC;
     }
 
+    gi.WriteByte(SVC_CONFIGSTRING);
+    gi.WriteShort(CS_STATUSBAR);
+    gi.WriteString(buffer);
     gi.unicast(ent, true);
 }
 
@@ -2810,7 +3243,9 @@ void G_BeginRoundIntermission(arena_t *a) {
         return;
     }
     a->state = ARENA_STATE_RINTERMISSION;
-    G_ShowScores(a);
+    G_FoldRoundStats(a);
+    G_LogRoundEnd(a);
+    G_ArenaQueueWork(a, ARENA_WORK_SCORES);
     ClockStartIntermission(a);
 }
 
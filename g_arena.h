@@ -50,6 +50,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define FOR_EACH_ARENA(a) \
     LIST_FOR_EACH(arena_t, a, &g_arenalist, entry)
 
+// non-critical per-arena work that can be spread over frames,
+// see G_ArenaQueueWork() and G_RunArenaWork()
+#define ARENA_WORK_STATUS        BIT(0)  // CS_MATCH_STATUS string
+#define ARENA_WORK_STATUSBARS    BIT(1)  // player/spectator status bars
+#define ARENA_WORK_SCORES        BIT(2)  // intermission scoreboards
+#define ARENA_WORK_MAXDELAY      5       // frames before work ignores the budget
+
 typedef enum {
     HUD_DISABLED,   // not allowed
     HUD_ENABLED,    // allowed, but user controlled
@@ -110,6 +117,13 @@ typedef enum {
     SCOREMODE_FRAGS     // Only credit if you actually frag someone
 } scoremode_t;
 
+// running vote counts, see G_UpdateVoteTally()
+typedef struct {
+    int         eligible;       // clients allowed to vote
+    int         votes[2];       // non-admin no/yes
+    int         admin[2];       // admin no/yes
+} vote_tally_t;
+
 typedef struct {
     int32_t     proposal;                    // which VOTE_*
     int8_t      index;                       // matches index in client_level_t
@@ -121,6 +135,7 @@ typedef struct {
     uint16_t    items[MAX_INVENTORY];        // ammo
     qboolean    infinite[MAX_INVENTORY];     // inf ammo
     char        original[MAX_STRING_CHARS];  // the original vote command
+    vote_tally_t    tally;
 } arena_vote_t;
 
 // don't change the order of these
@@ -167,6 +182,17 @@ typedef struct {
     list_t     entry;
 } arena_team_t;
 
+/**
+ * Inventory resolved from an arena's weapon flags and ammo settings. Rebuilt
+ * by G_BuildLoadout() whenever those change so spawning and refilling players
+ * is a straight copy instead of a pass over the flags.
+ */
+typedef struct {
+    int        spawn[MAX_INVENTORY];     // weapons + ammo handed out on spawn
+    int        refill[MAX_INVENTORY];    // ammo restored at the start of rounds
+    char       weapons[200];             // G_WeaponFlagsToString()
+    char       damage[200];              // G_DamageFlagsToString()
+} arena_loadout_t;
 
 typedef struct {
     uint8_t         number;                      // level.arenas[] index
@@ -221,6 +247,14 @@ typedef struct {
     arena_clock_t   clock;                       // match countdown, timer, intermission
     arena_clock_t   timeout_clock;               // used for timeouts
     scoremode_t     scoremode;                   // how players are scored
+    uint32_t        work;                        // pending ARENA_WORK_* flags
+    int32_t         work_frame;                  // when the oldest pending work was queued
+    arena_loadout_t loadout;                     // resolved spawn inventory
+    struct {
+        uint32_t    messages;                    // effects multicast from this arena
+        uint32_t    sends;                       // copies unicast to members
+        uint32_t    bytes;                       // total bytes of those copies
+    } multicast;
 } arena_t;
 
 // maps contain multiple arenas
@@ -249,6 +283,16 @@ typedef struct {
     qboolean    infinite[MAX_INVENTORY];
 } arena_entry_t;
 
+// mapcfg cache counters, see G_ParseMapSettings()
+typedef struct {
+    uint32_t    cached;     // files currently held
+    uint32_t    hits;       // map loads served from memory
+    uint32_t    misses;     // map loads that had to (re)parse
+    uint32_t    reads;      // files actually opened and parsed
+} mapcfg_stats_t;
+
+extern mapcfg_stats_t mapcfg_stats;
+
 void ClockEndIntermission(arena_clock_t *c, arena_t *a);
 void ClockEndMatchIntermission(arena_clock_t *c, arena_t *a);
 void ClockEndTimeout(arena_clock_t *c, arena_t *a);
@@ -259,12 +303,19 @@ void ClockStartRoundCountdown(arena_t *a);
 void ClockStartTimeout(arena_t *a);
 const char *DemoName(edict_t *ent);
 void G_ArenaCast(arena_t *a, qboolean reliable);
+arena_t *G_EdictArena(edict_t *ent);
+void G_ArenaMulticast(vec3_t origin, multicast_t to, arena_t *a);
+void G_WriteByte(int c);
+void G_WriteShort(int c);
+void G_WritePosition(vec3_t pos);
+void G_WriteDir(vec3_t dir);
 qboolean G_Arenamates(edict_t *p1, edict_t *p2);
 char *G_ArenaModeString(arena_t *a);
 void G_ArenaPlayerboardMessage(edict_t *ent, qboolean reliable);
 void G_ArenaScoreboardMessage(edict_t *ent, qboolean reliable);
 void G_ArenaSound(arena_t *a, int index);
 void G_ArenaStuff(arena_t *a, const char *command);
+void G_ArenaQueueWork(arena_t *a, uint32_t work);
 void G_ArenaThink(arena_t *a);
 void G_AsciiToConsole(char *out, char *in);
 void G_bprintf(arena_t *arena, int level, const char *fmt, ...);
@@ -286,8 +337,10 @@ void G_ChangeArena(edict_t *ent, arena_t *arena);
 void G_ClearRoundInfo(arena_t *a);
 void G_ConfigString(arena_t *arena, uint16_t index, const char *string);
 void G_CountEveryone(arena_t *a);
-const char *G_CreatePlayerStatusBar(edict_t *player);
+size_t G_BuildPlayerStatusBar(char *buffer, edict_t *player);
+size_t G_BuildSpectatorStatusBar(char *buffer, edict_t *player);
 char *G_DamageFlagsToString(uint32_t df);
+char *G_DamageFlagsToString_r(uint32_t df, char *str, size_t size);
 void G_EndMatch(arena_t *a, arena_team_t *winner);
 void G_EndRound(arena_t *a, arena_team_t *winner);
 void G_FinishArenaVote(arena_t *a);
@@ -304,6 +357,7 @@ void G_TeamJoin(edict_t *ent, arena_team_type_t type, qboolean forced);
 void G_MergeArenaSettings(arena_t *a, arena_entry_t *m);
 void G_MovePlayerToSpawnSpot(edict_t *ent, edict_t *spot);
 size_t G_ParseMapSettings(arena_entry_t *entry, const char *mapname);
+void G_FlushMapSettings(void);
 int G_PlayerCmp(const void *p1, const void *p2);
 void G_TeamPart(edict_t *ent, qboolean silent);
 void G_RandomizeAmmo(uint16_t *out);
@@ -314,7 +368,9 @@ void G_RemoveAllTeamPlayers(arena_team_t *team, qboolean silent);
 void G_ResetArena(arena_t *a);
 void G_ResetTeam(arena_team_t *t);
 void G_RespawnPlayers(arena_t *a);
+void G_RunArenaWork(void);
 char *G_RoundToString(arena_t *a);
+char *G_RoundToString_r(arena_t *a, char *out, size_t size);
 void G_RoundTimelimitHit(arena_clock_t *c, arena_t *a);
 void G_SecsToString(char *out, int seconds);
 void G_SelectBestWeapon(edict_t *ent);
@@ -335,6 +391,7 @@ void G_UpdatePlayerStatusBars(arena_t *a);
 void G_UpdateSkins(edict_t *ent);
 char *G_WeaponFlagsToString(arena_t *a);
 void G_BeginRoundIntermission(arena_t *a);
+void G_BuildLoadout(arena_t *a);
 void G_EndRoundIntermission(arena_t *a);
 void G_ApplyDefaults(arena_t *a);
 void update_playercounts(arena_t *a);
@@ -0,0 +1,417 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_cache.c -- binary snapshot of parsed config files
+
+#include "g_local.h"
+
+/**
+ * Cache file layout, all fields in host byte order:
+ *
+ *   cache_header_t
+ *   numrecords x { cache_record_t, path (pathlen bytes), data (datalen bytes) }
+ *
+ * Each record remembers the mtime and size of the text file it was parsed
+ * from. A record is only used while those still match, otherwise the caller
+ * falls back to the text parser and stores a fresh record.
+ */
+#define CACHE_MAGIC     MakeRawLong('R', 'A', '2', 'C')
+#define CACHE_VERSION   1
+#define CACHE_DIR       "/cache"
+#define CACHE_FILE      "/cache/config.bin"
+
+typedef struct {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    layout;     // struct sizes the records depend on
+    uint32_t    numrecords;
+    uint32_t    size;       // bytes following the header
+    uint32_t    checksum;   // FNV-1a of those bytes
+} cache_header_t;
+
+typedef struct {
+    uint32_t    type;
+    uint32_t    pathlen;    // including the terminating 0
+    uint32_t    datalen;
+    uint32_t    pad;
+    int64_t     mtime;
+    int64_t     size;
+} cache_record_t;
+
+typedef struct {
+    list_t      entry;
+    cache_type_t    type;
+    int64_t     mtime;
+    int64_t     size;
+    size_t      datalen;
+    byte        *data;
+    char        path[1];
+} cache_entry_t;
+
+// changes whenever a cached structure changes size
+#define CACHE_LAYOUT    ((uint32_t)(sizeof(arena_entry_t) * MAX_ARENAS))
+
+#define CACHE_MAX_SIZE  0x1000000
+
+static LIST_DECL(cache_entries);
+static qboolean cache_dirty;
+
+cache_stats_t cache_stats;
+
+/**
+ *
+ */
+uint32_t G_CacheChecksum(const void *data, size_t len) {
+    const byte *p = data;
+    uint32_t hash = 2166136261u;
+
+    while (len--) {
+        hash = (hash ^ *p++) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ *
+ */
+static size_t G_CachePath(char *path, size_t size) {
+    if (!game.dir[0]) {
+        return 0;
+    }
+    return Q_concat(path, size, game.dir, CACHE_FILE, NULL);
+}
+
+/**
+ *
+ */
+static cache_entry_t *G_CacheEntry(cache_type_t type, const char *path) {
+    cache_entry_t *e;
+
+    LIST_FOR_EACH(cache_entry_t, e, &cache_entries, entry) {
+        if (e->type == type && !strcmp(e->path, path)) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ *
+ */
+static void G_CacheRemove(cache_entry_t *e) {
+    List_Remove(&e->entry);
+    gi.TagFree(e);
+    cache_stats.records--;
+}
+
+/**
+ * Add a record, the data is copied into the same allocation
+ */
+static void G_CacheAdd(cache_type_t type, const char *path, int64_t mtime,
+        int64_t size, const void *data, size_t datalen) {
+    cache_entry_t *e;
+    size_t pathlen = strlen(path);
+
+    e = G_CacheEntry(type, path);
+    if (e) {
+        G_CacheRemove(e);
+    }
+
+    e = G_Malloc(sizeof(*e) + pathlen + datalen);
+    e->type = type;
+    e->mtime = mtime;
+    e->size = size;
+    e->datalen = datalen;
+    memcpy(e->path, path, pathlen + 1);
+    e->data = (byte *)e->path + pathlen + 1;
+    memcpy(e->data, data, datalen);
+
+    List_Append(&cache_entries, &e->entry);
+    cache_stats.records++;
+}
+
+/**
+ * Read the snapshot written by a previous run (possibly by another server
+ * sharing this game dir). Anything that doesn't validate is ignored, the
+ * text files are still there to parse.
+ */
+void G_LoadConfigCache(void) {
+    char path[MAX_OSPATH];
+    cache_header_t header;
+    cache_record_t rec;
+    byte *buffer, *p, *end;
+    FILE *fp;
+    uint32_t i;
+
+    G_FreeConfigCache();
+
+    if (!g_config_cache->value) {
+        return;
+    }
+
+    if (G_CachePath(path, sizeof(path)) >= sizeof(path)) {
+        return;
+    }
+
+    fp = fopen(path, "rb");
+    if (!fp) {
+        return;
+    }
+
+    buffer = NULL;
+    if (fread(&header, sizeof(header), 1, fp) != 1) {
+        goto fail;
+    }
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION ||
+            header.layout != CACHE_LAYOUT || header.size > CACHE_MAX_SIZE) {
+        goto fail;
+    }
+
+    buffer = G_Malloc(header.size + 1);
+    if (fread(buffer, 1, header.size, fp) != header.size) {
+        goto fail;
+    }
+    if (G_CacheChecksum(buffer, header.size) != header.checksum) {
+        goto fail;
+    }
+
+    p = buffer;
+    end = buffer + header.size;
+    for (i = 0; i < header.numrecords; i++) {
+        if ((size_t)(end - p) < sizeof(rec)) {
+            goto fail;
+        }
+        memcpy(&rec, p, sizeof(rec));
+        p += sizeof(rec);
+
+        if (rec.type >= CACHE_TOTAL || !rec.pathlen || rec.pathlen > MAX_OSPATH ||
+                (size_t)(end - p) < (size_t)rec.pathlen + rec.datalen) {
+            goto fail;
+        }
+        if (p[rec.pathlen - 1]) {
+            goto fail;
+        }
+        G_CacheAdd(rec.type, (char *)p, rec.mtime, rec.size,
+                p + rec.pathlen, rec.datalen);
+        p += rec.pathlen + rec.datalen;
+    }
+
+    fclose(fp);
+    gi.TagFree(buffer);
+    cache_dirty = qfalse;
+    gi.dprintf("Loaded %u config cache records from '%s'\n", cache_stats.records, path);
+    return;
+
+fail:
+    gi.dprintf("Ignoring invalid config cache '%s'\n", path);
+    fclose(fp);
+    if (buffer) {
+        gi.TagFree(buffer);
+    }
+    G_FreeConfigCache();
+}
+
+/**
+ * Write the snapshot back out if anything was added since it was loaded.
+ *
+ * Several servers can share one game dir, so write to a private temp file
+ * and rename it over the old snapshot.
+ */
+void G_SaveConfigCache(void) {
+    char path[MAX_OSPATH], temp[MAX_OSPATH];
+    cache_header_t header;
+    cache_record_t rec;
+    cache_entry_t *e;
+    byte *buffer, *p;
+    size_t len;
+    FILE *fp;
+
+    if (!cache_dirty || !g_config_cache->value) {
+        return;
+    }
+    cache_dirty = qfalse;
+
+    len = G_CachePath(path, sizeof(path));
+    if (!len || len >= sizeof(path)) {
+        return;
+    }
+    len = Q_snprintf(temp, sizeof(temp), "%s.%d", path, (int)os_getpid());
+    if (len >= sizeof(temp)) {
+        return;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.layout = CACHE_LAYOUT;
+
+    LIST_FOR_EACH(cache_entry_t, e, &cache_entries, entry) {
+        header.size += sizeof(rec) + strlen(e->path) + 1 + e->datalen;
+        header.numrecords++;
+    }
+    if (header.size > CACHE_MAX_SIZE) {
+        return;
+    }
+
+    buffer = p = G_Malloc(header.size + 1);
+    LIST_FOR_EACH(cache_entry_t, e, &cache_entries, entry) {
+        memset(&rec, 0, sizeof(rec));
+        rec.type = e->type;
+        rec.pathlen = strlen(e->path) + 1;
+        rec.datalen = e->datalen;
+        rec.mtime = e->mtime;
+        rec.size = e->size;
+
+        memcpy(p, &rec, sizeof(rec));
+        p += sizeof(rec);
+        memcpy(p, e->path, rec.pathlen);
+        p += rec.pathlen;
+        memcpy(p, e->data, e->datalen);
+        p += e->datalen;
+    }
+    header.checksum = G_CacheChecksum(buffer, header.size);
+
+    Q_concat(path, sizeof(path), game.dir, CACHE_DIR, NULL);
+    os_mkdir(path);
+    G_CachePath(path, sizeof(path));
+
+    fp = fopen(temp, "wb");
+    if (!fp) {
+        gi.TagFree(buffer);
+        return;
+    }
+    if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+            fwrite(buffer, 1, header.size, fp) != header.size) {
+        fclose(fp);
+        os_unlink(temp);
+        gi.TagFree(buffer);
+        return;
+    }
+    fclose(fp);
+    gi.TagFree(buffer);
+
+#ifdef _WIN32
+    os_unlink(path);
+#endif
+    if (rename(temp, path)) {
+        os_unlink(temp);
+        return;
+    }
+    cache_stats.writes++;
+}
+
+/**
+ * Drop every record, the next load parses the text files again
+ */
+void G_FreeConfigCache(void) {
+    cache_entry_t *e, *next;
+
+    LIST_FOR_EACH_SAFE(cache_entry_t, e, next, &cache_entries, entry) {
+        gi.TagFree(e);
+    }
+    List_Init(&cache_entries);
+    cache_stats.records = 0;
+    cache_dirty = qfalse;
+}
+
+/**
+ * Drop every record and rewrite the snapshot on the next save, so files
+ * that changed without a new mtime or size get parsed again
+ */
+void G_InvalidateConfigCache(void) {
+    G_FreeConfigCache();
+    cache_dirty = qtrue;
+}
+
+/**
+ * Find the parsed form of the text file at path. Returns NULL if there is no
+ * record or the file changed since the record was made.
+ */
+const void *G_CacheFind(cache_type_t type, const char *path, size_t *len) {
+    cache_entry_t *e;
+    Q_STATBUF st;
+
+    if (!g_config_cache->value) {
+        return NULL;
+    }
+
+    e = G_CacheEntry(type, path);
+    if (!e) {
+        cache_stats.misses++;
+        return NULL;
+    }
+
+    if (os_stat(path, &st) || e->mtime != (int64_t)st.st_mtime ||
+            e->size != (int64_t)st.st_size) {
+        G_CacheRemove(e);
+        cache_stats.misses++;
+        return NULL;
+    }
+
+    cache_stats.hits++;
+    *len = e->datalen;
+    return e->data;
+}
+
+/**
+ * Remember the parsed form of the text file at path, stamped with its current
+ * mtime and size. Written to disk by the next G_SaveConfigCache().
+ */
+void G_CacheStore(cache_type_t type, const char *path, const void *data, size_t len) {
+    Q_STATBUF st;
+
+    if (!g_config_cache->value) {
+        return;
+    }
+    if (os_stat(path, &st)) {
+        return;
+    }
+    G_CacheAdd(type, path, st.st_mtime, st.st_size, data, len);
+    cache_dirty = qtrue;
+}
+
+/**
+ * Append len bytes to a growing blob, used to collect parsed output before
+ * handing it to G_CacheStore()
+ */
+void G_BlobAppend(cache_blob_t *b, const void *data, size_t len) {
+    byte *grown;
+
+    if (b->len + len > b->size) {
+        b->size = max(b->size * 2, b->len + len + 256);
+        grown = G_Malloc(b->size);
+        if (b->data) {
+            memcpy(grown, b->data, b->len);
+            gi.TagFree(b->data);
+        }
+        b->data = grown;
+    }
+    memcpy(b->data + b->len, data, len);
+    b->len += len;
+}
+
+/**
+ *
+ */
+void G_BlobFree(cache_blob_t *b) {
+    if (b->data) {
+        gi.TagFree(b->data);
+    }
+    memset(b, 0, sizeof(*b));
+}
@@ -0,0 +1,218 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_clip.c -- game side broadphase for entity only queries
+
+#include "g_local.h"
+
+/**
+ * Players and FL_NOCLIP_PROJECTILE entities are tracked here so that queries
+ * which only care about them (projectile touches, id view) can test their
+ * boxes directly instead of going through gi.trace() and the BSP.
+ *
+ * Boxes are read from the edicts at query time, nothing is cached, so there
+ * is nothing to update when they move. Projectiles are kept in
+ * level.projectiles.list by G_AddProjectile()/G_FreeEdict().
+ */
+
+/**
+ * Where does the segment start + frac * delta enter the box? Returns qfalse
+ * if it misses. Starting inside the box is a hit at frac 0.
+ */
+qboolean G_RayBox(vec3_t start, vec3_t delta, vec3_t mins, vec3_t maxs,
+        float *frac, vec3_t normal) {
+    float enter = 0, leave = 1, t1, t2, t;
+    int i, axis = -1;
+    float sign = 0;
+
+    for (i = 0; i < 3; i++) {
+        if (delta[i] == 0) {
+            if (start[i] < mins[i] || start[i] > maxs[i]) {
+                return qfalse;
+            }
+            continue;
+        }
+        t1 = (mins[i] - start[i]) / delta[i];
+        t2 = (maxs[i] - start[i]) / delta[i];
+        if (t1 > t2) {
+            t = t1, t1 = t2, t2 = t;
+        }
+        if (t1 > enter) {
+            enter = t1;
+            axis = i;
+            sign = delta[i] > 0 ? -1 : 1;
+        }
+        if (t2 < leave) {
+            leave = t2;
+        }
+        if (enter > leave) {
+            return qfalse;
+        }
+    }
+
+    *frac = enter;
+    VectorClear(normal);
+    if (axis >= 0) {
+        normal[axis] = sign;
+    }
+    return qtrue;
+}
+
+/**
+ * Add a projectile to the broadphase
+ */
+void G_ClipLink(edict_t *e) {
+    if (level.projectiles.count < MAX_EDICTS) {
+        level.projectiles.list[level.projectiles.count++] = e;
+    }
+}
+
+/**
+ * Remove a projectile from the broadphase
+ */
+void G_ClipUnlink(edict_t *e) {
+    int i;
+
+    for (i = 0; i < level.projectiles.count; i++) {
+        if (level.projectiles.list[i] == e) {
+            level.projectiles.list[i] = level.projectiles.list[--level.projectiles.count];
+            return;
+        }
+    }
+}
+
+/**
+ * Fill list with what the mask asks for, in edict order for players
+ */
+static int G_ClipCandidates(int mask, edict_t **list) {
+    edict_t *e;
+    int i, count = 0;
+
+    if (mask & CLIP_PLAYERS) {
+        for (i = 1; i <= game.maxclients; i++) {
+            e = &g_edicts[i];
+            if (e->inuse && e->solid != SOLID_NOT) {
+                list[count++] = e;
+            }
+        }
+    }
+    if (mask & CLIP_PROJECTILES) {
+        for (i = 0; i < level.projectiles.count; i++) {
+            list[count++] = level.projectiles.list[i];
+        }
+    }
+    return count;
+}
+
+/**
+ * Same skipping gi.trace() does for passent
+ */
+static qboolean G_ClipPass(edict_t *e, edict_t *passent) {
+    if (!passent) {
+        return qfalse;
+    }
+    return e == passent || e->owner == passent || (passent->owner && passent->owner == e);
+}
+
+/**
+ *
+ */
+static int ClipHitCmp(const void *a, const void *b) {
+    const clip_hit_t *h1 = a, *h2 = b;
+
+    if (h1->fraction < h2->fraction) {
+        return -1;
+    }
+    return h1->fraction > h2->fraction;
+}
+
+/**
+ * Every tracked entity whose box overlaps mins/maxs
+ */
+int G_ClipBoxes(vec3_t mins, vec3_t maxs, int mask, edict_t **list, int maxcount) {
+    edict_t *cand[MAX_CLIENTS + MAX_EDICTS];
+    edict_t *e;
+    int i, j, num, count = 0;
+
+    num = G_ClipCandidates(mask, cand);
+    for (i = 0; i < num && count < maxcount; i++) {
+        e = cand[i];
+        for (j = 0; j < 3; j++) {
+            if (e->s.origin[j] + e->mins[j] > maxs[j] ||
+                    e->s.origin[j] + e->maxs[j] < mins[j]) {
+                break;
+            }
+        }
+        if (j == 3) {
+            list[count++] = e;
+        }
+    }
+    return count;
+}
+
+/**
+ * Sweep a box from start to end against the tracked entities, like a
+ * gi.trace() that passes through everything it hits and never sees the
+ * world. Hits come back nearest first.
+ */
+int G_ClipMove(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end,
+        edict_t *passent, int mask, clip_hit_t *hits, int maxhits) {
+    static clip_hit_t found[MAX_CLIENTS + MAX_EDICTS];
+    edict_t *cand[MAX_CLIENTS + MAX_EDICTS];
+    vec3_t delta, bmins, bmaxs, normal;
+    edict_t *e;
+    float frac;
+    int i, j, num, count = 0;
+
+    if (!mins) {
+        mins = vec3_origin;
+    }
+    if (!maxs) {
+        maxs = vec3_origin;
+    }
+
+    VectorSubtract(end, start, delta);
+    num = G_ClipCandidates(mask, cand);
+    for (i = 0; i < num; i++) {
+        e = cand[i];
+        if (G_ClipPass(e, passent)) {
+            continue;
+        }
+
+        // grow the target by the moving box and trace a point
+        for (j = 0; j < 3; j++) {
+            bmins[j] = e->s.origin[j] + e->mins[j] - maxs[j];
+            bmaxs[j] = e->s.origin[j] + e->maxs[j] - mins[j];
+        }
+        if (!G_RayBox(start, delta, bmins, bmaxs, &frac, normal)) {
+            continue;
+        }
+
+        found[count].ent = e;
+        found[count].fraction = frac;
+        VectorMA(start, frac, delta, found[count].endpos);
+        VectorCopy(normal, found[count].normal);
+        count++;
+    }
+
+    qsort(found, count, sizeof(found[0]), ClipHitCmp);
+    count = min(count, maxhits);
+    memcpy(hits, found, count * sizeof(hits[0]));
+    return count;
+}
@@ -111,7 +111,7 @@ void ClockPostThink(arena_clock_t *c) {
         return;
     }
 
-    G_UpdateConfigStrings(a);
+    G_ArenaQueueWork(a, ARENA_WORK_STATUS);
     if (a->state == ARENA_STATE_COUNTDOWN) {
         a->countdown = c->value; // for center screen number
         if (c->value > 0 && c->value <= 10) {
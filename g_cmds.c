@@ -1266,6 +1266,7 @@ static void Cmd_Sound_f(edict_t *ent) {
  */
 void Cmd_Stats_f(edict_t *ent, qboolean check_other) {
     int i;
+    playerstats_t stats;
     fragstat_t *s;
     char acc[16];
     char hits[16];
@@ -1293,8 +1294,9 @@ void Cmd_Stats_f(edict_t *ent, qboolean check_other) {
         other = ent;
     }
 
+    G_ClientStats(other->client, &stats);
     for (i = FRAG_BLASTER; i <= FRAG_BFG; i++) {
-        s = &other->client->resp.frags[i];
+        s = &stats.frags[i];
         if (s->atts || s->deaths) {
             break;
         }
@@ -1313,7 +1315,7 @@ void Cmd_Stats_f(edict_t *ent, qboolean check_other) {
                other->client->pers.netname);
 
     for (i = FRAG_BLASTER; i <= FRAG_BFG; i++) {
-        s = &other->client->resp.frags[i];
+        s = &stats.frags[i];
         if (!s->atts && !s->deaths) {
             continue;
         }
@@ -1344,8 +1346,7 @@ void Cmd_Stats_f(edict_t *ent, qboolean check_other) {
 
     gi.cprintf(ent, PRINT_HIGH,
                "Total damage given/recvd: %d/%d\n",
-               other->client->resp.damage_given,
-               other->client->resp.damage_recvd);
+               stats.damage_given, stats.damage_recvd);
 }
 
 /**
@@ -1363,7 +1364,7 @@ static void Cmd_Id_f(edict_t *ent) {
  */
 void Cmd_Settings_f(edict_t *ent) {
     gi.cprintf(ent, PRINT_HIGH, "Weapons:       %s\n", G_WeaponFlagsToString(ARENA(ent)));
-    gi.cprintf(ent, PRINT_HIGH, "Damage:        %s\n", G_DamageFlagsToString(ARENA(ent)->damage_flags));
+    gi.cprintf(ent, PRINT_HIGH, "Damage:        %s\n", ARENA(ent)->loadout.damage);
     gi.cprintf(ent, PRINT_HIGH, "Rounds:        %d\n", ARENA(ent)->round_limit);
     gi.cprintf(ent, PRINT_HIGH, "Teams:         %d\n", ARENA(ent)->team_count);
     gi.cprintf(ent, PRINT_HIGH, "Health:        %d\n", ARENA(ent)->health);
@@ -1389,6 +1390,7 @@ static void Cmd_Admin_f(edict_t *ent) {
         gi.bprintf(PRINT_HIGH, "%s is no longer an admin.\n",
                    ent->client->pers.netname);
         ent->client->pers.admin = qfalse;
+        G_UpdateVoteTally(ent->client);
         return;
     }
 
@@ -1409,6 +1411,7 @@ static void Cmd_Admin_f(edict_t *ent) {
 
     ent->client->pers.admin = qtrue;
     gi.bprintf(PRINT_HIGH, "%s is now an admin.\n", ent->client->pers.netname);
+    G_UpdateVoteTally(ent->client);
 
     G_CheckVote(); // admin's vote wins automatically
     G_CheckArenaVote(ARENA(ent)); // ditto
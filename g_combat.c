@@ -104,14 +104,14 @@ static void Killed(edict_t *targ, edict_t *inflictor, edict_t *attacker, int dam
 }
 
 /**
- * Show damage in the world
+ * Show damage in the world, only to the arena ent belongs to
  */
-static void SpawnDamage(int type, vec3_t origin, vec3_t normal) {
-    gi.WriteByte(SVC_TEMP_ENTITY);
-    gi.WriteByte(type);
-    gi.WritePosition(origin);
-    gi.WriteDir(normal);
-    gi.multicast(origin, MULTICAST_PVS);
+static void SpawnDamage(edict_t *ent, int type, vec3_t origin, vec3_t normal) {
+    G_WriteByte(SVC_TEMP_ENTITY);
+    G_WriteByte(type);
+    G_WritePosition(origin);
+    G_WriteDir(normal);
+    G_ArenaMulticast(origin, MULTICAST_PVS, G_EdictArena(ent));
 }
 
 /**
@@ -180,7 +180,7 @@ static int CheckPowerArmor(edict_t *ent, vec3_t point, vec3_t normal, int damage
         save = damage;
     }
 
-    SpawnDamage(pa_te_type, point, normal);
+    SpawnDamage(ent, pa_te_type, point, normal);
     client->powerarmor_framenum = level.framenum + 0.2 * HZ;
 
     power_used = save / damagePerCell;
@@ -233,7 +233,7 @@ static int CheckArmor(edict_t *ent, vec3_t point, vec3_t normal, int damage, int
     }
 
     client->inventory[index] -= save;
-    SpawnDamage(te_sparks, point, normal);
+    SpawnDamage(ent, te_sparks, point, normal);
 
     return save;
 }
@@ -356,13 +356,13 @@ void T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
     if ((targ->flags & FL_GODMODE) && !(dflags & DAMAGE_NO_PROTECTION)) {
         take = 0;
         save = damage;
-        SpawnDamage(te_sparks, point, normal);
+        SpawnDamage(targ, te_sparks, point, normal);
     }
 
     // check for invincibility
     if ((client && client->invincible_framenum > level.framenum) && !(dflags & DAMAGE_NO_PROTECTION)) {
         if (targ->pain_debounce_framenum < level.framenum) {
-            gi.sound(targ, CHAN_ITEM, gi.soundindex("items/protect4.wav"), 1, ATTN_NORM, 0);
+            gi.sound(targ, CHAN_ITEM, level.sounds.protect[2], 1, ATTN_NORM, 0);
             targ->pain_debounce_framenum = level.framenum + 2 * HZ;
         }
         take = 0;
@@ -429,14 +429,14 @@ void T_Damage(edict_t *targ, edict_t *inflictor, edict_t *attacker, vec3_t dir,
     if (take) {
         if (client) {
             if (targ == attacker) {
-                SpawnDamage(TE_BLOOD, targ->s.origin, normal);
+                SpawnDamage(targ, TE_BLOOD, targ->s.origin, normal);
             } else {
-                SpawnDamage(TE_BLOOD, point, normal);
+                SpawnDamage(targ, TE_BLOOD, point, normal);
             }
         } else if (targ == attacker) {
-            SpawnDamage(TE_SPARKS, targ->s.origin, normal);
+            SpawnDamage(targ, TE_SPARKS, targ->s.origin, normal);
         } else {
-            SpawnDamage(TE_SPARKS, point, normal);
+            SpawnDamage(targ, TE_SPARKS, point, normal);
         }
 
         // hurting someone else
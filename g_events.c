@@ -0,0 +1,277 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_events.c -- binary match event log
+
+#include "g_local.h"
+#include "g_events.h"
+
+/**
+ * Round level events are appended to a memory buffer as they happen, which
+ * is only a copy. The buffer goes to disk when a round or match ends, when
+ * the level changes or the game shuts down, or when it fills up. Decode the
+ * files with the ra2events tool built next to the game module.
+ */
+#define EVENTS_DIR      "/events"
+#define EVENTS_BUFSIZE  0x10000
+
+static FILE     *ev_file;
+static byte     ev_buffer[EVENTS_BUFSIZE];
+static size_t   ev_len;
+
+events_stats_t  events_stats;
+
+/**
+ * Write out whatever is buffered
+ */
+void G_FlushEvents(void) {
+    if (!ev_file || !ev_len) {
+        ev_len = 0;
+        return;
+    }
+    if (fwrite(ev_buffer, 1, ev_len, ev_file) != ev_len) {
+        gi.dprintf("Couldn't write event log, closing it\n");
+        fclose(ev_file);
+        ev_file = NULL;
+    } else {
+        fflush(ev_file);
+        events_stats.flushes++;
+        events_stats.bytes += ev_len;
+    }
+    ev_len = 0;
+}
+
+/**
+ *
+ */
+void G_CloseEventLog(void) {
+    G_FlushEvents();
+    if (ev_file) {
+        fclose(ev_file);
+        ev_file = NULL;
+    }
+}
+
+/**
+ * Append one event, payload is len bytes
+ */
+static void G_LogEvent(ev_type_t type, int arena, const void *payload, size_t len) {
+    ev_record_t rec;
+
+    if (!ev_file) {
+        return;
+    }
+    if (ev_len + sizeof(rec) + len > sizeof(ev_buffer)) {
+        G_FlushEvents();
+        if (!ev_file) {
+            return;
+        }
+    }
+
+    rec.len = len;
+    rec.type = type;
+    rec.arena = arena;
+    rec.frame = level.framenum;
+    memcpy(ev_buffer + ev_len, &rec, sizeof(rec));
+    memcpy(ev_buffer + ev_len + sizeof(rec), payload, len);
+    ev_len += sizeof(rec) + len;
+    events_stats.events++;
+}
+
+/**
+ *
+ */
+static int G_EventClient(edict_t *ent) {
+    if (!ent || !ent->client) {
+        return EVENTS_NOCLIENT;
+    }
+    return ent->client - game.clients;
+}
+
+/**
+ *
+ */
+static int G_EventArena(edict_t *ent) {
+    if (!ent || !ent->client || !ARENA(ent)) {
+        return 0;
+    }
+    return ARENA(ent)->number;
+}
+
+/**
+ * Start a new log for this level, called from G_SpawnEntities()
+ */
+void G_OpenEventLog(const char *mapname) {
+    char path[MAX_OSPATH];
+    ev_header_t header;
+    struct tm tm;
+    time_t t;
+    int i;
+
+    G_CloseEventLog();
+
+    if (!g_event_log->value || !game.dir[0]) {
+        return;
+    }
+
+    t = time(NULL);
+    if (!os_localtime(&t, &tm)) {
+        return;
+    }
+
+    Q_concat(path, sizeof(path), game.dir, EVENTS_DIR, NULL);
+    os_mkdir(path);
+    if (Q_snprintf(path, sizeof(path), "%s%s/%s-%04d%02d%02d-%02d%02d%02d-%d.evl",
+                   game.dir, EVENTS_DIR, mapname, tm.tm_year + 1900, tm.tm_mon + 1,
+                   tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                   (int)os_getpid()) >= sizeof(path)) {
+        return;
+    }
+
+    ev_file = fopen(path, "wb");
+    if (!ev_file) {
+        gi.dprintf("Couldn't open event log %s\n", path);
+        return;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = EVENTS_MAGIC;
+    header.version = EVENTS_VERSION;
+    header.time = t;
+    Q_strlcpy(header.mapname, mapname, sizeof(header.mapname));
+    memcpy(ev_buffer, &header, sizeof(header));
+    ev_len = sizeof(header);
+    events_stats.files++;
+
+    // clients carried over from the last level
+    for (i = 0; i < game.maxclients; i++) {
+        if (game.clients[i].pers.connected > CONN_CONNECTED) {
+            G_LogClientEvent(g_edicts + i + 1);
+        }
+    }
+}
+
+/**
+ * Map a client number to a name for everything after this
+ */
+void G_LogClientEvent(edict_t *ent) {
+    ev_client_t ev;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.client = G_EventClient(ent);
+    Q_strlcpy(ev.name, ent->client->pers.netname, sizeof(ev.name));
+    G_LogEvent(EV_CLIENT, 0, &ev, sizeof(ev));
+}
+
+/**
+ * Round is starting, with who is on which team
+ */
+void G_LogRoundStart(arena_t *a) {
+    struct {
+        ev_round_start_t    start;
+        ev_roster_t         roster[MAX_TEAMS * MAX_TEAM_PLAYERS];
+    } ev;
+    edict_t *ent;
+    int i, j;
+
+    ev.start.round = a->current_round;
+    ev.start.round_limit = a->round_limit;
+    ev.start.count = 0;
+    for (i = 0; i < a->team_count; i++) {
+        for (j = 0; j < MAX_TEAM_PLAYERS; j++) {
+            ent = a->teams[i].players[j];
+            if (!ent) {
+                continue;
+            }
+            ev.roster[ev.start.count].client = G_EventClient(ent);
+            ev.roster[ev.start.count].team = i;
+            ev.start.count++;
+        }
+    }
+    G_LogEvent(EV_ROUND_START, a->number, &ev,
+               sizeof(ev.start) + ev.start.count * sizeof(ev.roster[0]));
+}
+
+/**
+ * Round is over, the winner is the last team with anyone alive
+ */
+void G_LogRoundEnd(arena_t *a) {
+    ev_round_end_t ev;
+    int i;
+
+    ev.round = a->current_round;
+    ev.winner = EVENTS_NOCLIENT;
+    if (a->teams_alive == 1) {
+        for (i = 0; i < a->team_count; i++) {
+            if (a->teams[i].players_alive > 0) {
+                ev.winner = i;
+                break;
+            }
+        }
+    }
+    G_LogEvent(EV_ROUND_END, a->number, &ev, sizeof(ev));
+    G_FlushEvents();
+}
+
+/**
+ *
+ */
+void G_LogMatchEnd(arena_t *a, arena_team_t *winner) {
+    ev_match_end_t ev;
+
+    ev.winner = winner ? winner - a->teams : EVENTS_NOCLIENT;
+    G_LogEvent(EV_MATCH_END, a->number, &ev, sizeof(ev));
+    G_FlushEvents();
+}
+
+/**
+ *
+ */
+void G_LogDamage(edict_t *targ, edict_t *attacker, int points) {
+    ev_damage_t ev;
+
+    ev.attacker = G_EventClient(attacker);
+    ev.victim = G_EventClient(targ);
+    ev.mod = meansOfDeath;
+    ev.points = max(min(points, INT16_MAX), INT16_MIN);
+    G_LogEvent(EV_DAMAGE, G_EventArena(targ), &ev, sizeof(ev));
+}
+
+/**
+ *
+ */
+void G_LogKill(edict_t *self, edict_t *attacker) {
+    ev_kill_t ev;
+
+    ev.attacker = G_EventClient(attacker);
+    ev.victim = G_EventClient(self);
+    ev.mod = meansOfDeath;
+    G_LogEvent(EV_KILL, G_EventArena(self), &ev, sizeof(ev));
+}
+
+/**
+ *
+ */
+void G_LogPickup(edict_t *ent, int item) {
+    ev_pickup_t ev;
+
+    ev.client = G_EventClient(ent);
+    ev.item = item;
+    G_LogEvent(EV_PICKUP, G_EventArena(ent), &ev, sizeof(ev));
+}
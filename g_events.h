@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_events.h -- on-disk format of the match event log
+//
+// Shared by the game module and the ra2events decoder, so this only uses
+// fixed width types and nothing from the rest of the game headers.
+
+#ifndef G_EVENTS_H
+#define G_EVENTS_H
+
+#include <stdint.h>
+
+/**
+ * One file per level:
+ *
+ *   ev_header_t
+ *   ev_record_t + len bytes of payload, repeated until the end of the file
+ *
+ * All fields are in host byte order. Payload structs only contain bytes and
+ * 16 bit fields in an order that needs no padding, so they are written as is.
+ */
+#define EVENTS_MAGIC        0x45324152  // "RA2E"
+#define EVENTS_VERSION      1
+#define EVENTS_NOCLIENT     255         // world, or no team
+
+typedef struct {
+    uint32_t    magic;
+    uint32_t    version;
+    int64_t     time;           // when the level started
+    char        mapname[64];
+} ev_header_t;
+
+typedef struct {
+    uint16_t    len;            // payload bytes that follow
+    uint8_t     type;           // ev_type_t
+    uint8_t     arena;          // arena number, 0 for the server
+    uint32_t    frame;          // level.framenum
+} ev_record_t;
+
+typedef enum {
+    EV_CLIENT = 1,              // ev_client_t
+    EV_ROUND_START,             // ev_round_start_t, then count x ev_roster_t
+    EV_ROUND_END,               // ev_round_end_t
+    EV_MATCH_END,               // ev_match_end_t
+    EV_DAMAGE,                  // ev_damage_t
+    EV_KILL,                    // ev_kill_t
+    EV_PICKUP,                  // ev_pickup_t
+    EV_TOTAL
+} ev_type_t;
+
+typedef struct {
+    uint8_t     client;
+    char        name[16];
+} ev_client_t;
+
+typedef struct {
+    uint8_t     round;
+    uint8_t     round_limit;
+    uint8_t     count;
+} ev_round_start_t;
+
+typedef struct {
+    uint8_t     client;
+    uint8_t     team;           // arena teams[] index
+} ev_roster_t;
+
+typedef struct {
+    uint8_t     round;
+    uint8_t     winner;         // teams[] index, EVENTS_NOCLIENT for none
+} ev_round_end_t;
+
+typedef struct {
+    uint8_t     winner;
+} ev_match_end_t;
+
+typedef struct {
+    uint8_t     attacker;
+    uint8_t     victim;
+    uint16_t    mod;            // MOD_*, including MOD_FRIENDLY_FIRE
+    int16_t     points;         // health taken after armor
+} ev_damage_t;
+
+typedef struct {
+    uint8_t     attacker;       // EVENTS_NOCLIENT for the world
+    uint8_t     victim;
+    uint16_t    mod;
+} ev_kill_t;
+
+typedef struct {
+    uint8_t     client;
+    uint8_t     item;           // ITEM_* index
+} ev_pickup_t;
+
+#endif // G_EVENTS_H
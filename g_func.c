@@ -886,7 +886,7 @@ static void door_use_areaportals(edict_t *self, qboolean open) {
     }
 
     while ((t = G_Find(t, FOFS(targetname), self->target))) {
-        if (Q_stricmp(t->classname, "func_areaportal") == 0) {
+        if (G_ClassIs(t, level.classnames.func_areaportal)) {
             gi.SetAreaPortalState(t->style, open);
         }
     }
@@ -944,9 +944,9 @@ static void door_go_down(edict_t *self) {
     }
 
     self->moveinfo.state = STATE_DOWN;
-    if (strcmp(self->classname, "func_door") == 0) {
+    if (G_ClassIs(self, level.classnames.func_door)) {
         Move_Calc(self, door_hit_bottom);
-    } else if (strcmp(self->classname, "func_door_rotating") == 0) {
+    } else if (G_ClassIs(self, level.classnames.func_door_rotating)) {
         AngleMove_Calc(self, door_hit_bottom);
     }
 }
@@ -974,9 +974,9 @@ static void door_go_up(edict_t *self, edict_t *activator) {
         self->s.sound = self->moveinfo.sound_middle;
     }
     self->moveinfo.state = STATE_UP;
-    if (strcmp(self->classname, "func_door") == 0) {
+    if (G_ClassIs(self, level.classnames.func_door)) {
         Move_Calc(self, door_hit_top);
-    } else if (strcmp(self->classname, "func_door_rotating") == 0) {
+    } else if (G_ClassIs(self, level.classnames.func_door_rotating)) {
         AngleMove_Calc(self, door_hit_top);
     }
 
@@ -1464,7 +1464,7 @@ void SP_func_water(edict_t *self) {
     if (self->wait == -1) {
         self->spawnflags |= DOOR_TOGGLE;
     }
-    self->classname = "func_door";
+    self->classname = level.classnames.func_door;
     gi.linkentity(self);
 }
 
@@ -1735,7 +1735,7 @@ static void trigger_elevator_init(edict_t *self) {
         gi.dprintf("trigger_elevator unable to find target %s\n", self->target);
         return;
     }
-    if (strcmp(self->movetarget->classname, "func_train") != 0) {
+    if (!G_ClassIs(self->movetarget, level.classnames.func_train)) {
         gi.dprintf("trigger_elevator target %s is not a train\n", self->target);
         return;
     }
@@ -2017,7 +2017,7 @@ void SP_func_door_secret(edict_t *ent) {
         gi.soundindex("misc/talk.wav");
         ent->touch = door_touch;
     }
-    ent->classname = "func_door";
+    ent->classname = level.classnames.func_door;
     gi.linkentity(ent);
 }
 
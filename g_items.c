@@ -326,7 +326,7 @@ void Use_Quad(edict_t *ent, gitem_t *item) {
         ent->client->quad_framenum = level.framenum + timeout;
     }
     UpdateChaseTargets(CHASE_QUAD, ent);
-    gi.sound(ent, CHAN_ITEM, gi.soundindex("items/damage.wav"), 1, ATTN_NORM, 0);
+    gi.sound(ent, CHAN_ITEM, level.sounds.damage[0], 1, ATTN_NORM, 0);
 }
 
 /**
@@ -367,7 +367,7 @@ void Use_Invulnerability(edict_t *ent, gitem_t *item) {
         ent->client->invincible_framenum = level.framenum + 30 * HZ;
     }
     UpdateChaseTargets(CHASE_INVU, ent);
-    gi.sound(ent, CHAN_ITEM, gi.soundindex("items/protect.wav"), 1, ATTN_NORM, 0);
+    gi.sound(ent, CHAN_ITEM, level.sounds.protect[0], 1, ATTN_NORM, 0);
 }
 
 /**
@@ -663,14 +663,14 @@ int PowerArmorIndex(edict_t *ent) {
 void Use_PowerArmor(edict_t *ent, gitem_t *item) {
     if (ent->flags & FL_POWER_ARMOR) {
         ent->flags &= ~FL_POWER_ARMOR;
-        gi.sound(ent, CHAN_AUTO, gi.soundindex("misc/power2.wav"), 1, ATTN_NORM, 0);
+        gi.sound(ent, CHAN_AUTO, level.sounds.power[1], 1, ATTN_NORM, 0);
     } else {
         if (!ent->client->inventory[ITEM_CELLS]) {
             gi.cprintf(ent, PRINT_HIGH, "No cells for power armor.\n");
             return;
         }
         ent->flags |= FL_POWER_ARMOR;
-        gi.sound(ent, CHAN_AUTO, gi.soundindex("misc/power1.wav"), 1, ATTN_NORM, 0);
+        gi.sound(ent, CHAN_AUTO, level.sounds.power[0], 1, ATTN_NORM, 0);
     }
 }
 
@@ -707,8 +707,9 @@ void Drop_PowerArmor(edict_t *ent, gitem_t *item) {
  *
  */
 static void AccountItemPickup(edict_t *ent, edict_t *other) {
-    gclient_t *c;
-    int i, index = ITEM_INDEX(ent->item);
+    arena_team_t *team;
+    arena_t *a;
+    int i, t, index = ITEM_INDEX(ent->item);
 
     // its health, but not megahealth
     if (index == ITEM_HEALTH && !(ent->style & HEALTH_TIMED)) {
@@ -731,11 +732,18 @@ static void AccountItemPickup(edict_t *ent, edict_t *other) {
     }
 
     // by now we should have everything else - armor, weapons, powerups and mh
-    other->client->resp.items[index].pickups++;
-
-    for (i = 0, c = game.clients; i < game.maxclients; i++, c++) {
-        if (c->pers.connected == CONN_SPAWNED && c != other->client) {
-            c->resp.items[index].misses++;
+    G_PlayerStats(other)->items[index].pickups++;
+    G_LogPickup(other, index);
+
+    // everyone else playing in the arena missed it
+    a = ARENA(other);
+    for (t = 0; t < a->team_count; t++) {
+        team = &a->teams[t];
+        for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
+            if (team->players[i] && team->players[i] != other &&
+                    team->players[i]->client->pers.connected == CONN_SPAWNED) {
+                level.round_stats[a->number][t][i].items[index].misses++;
+            }
         }
     }
 }
@@ -781,7 +789,7 @@ void Touch_Item(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *surf)
                 gi.sound(other, CHAN_ITEM, gi.soundindex("items/m_health.wav"), 1, ATTN_NORM, 0);
             }
         } else if (ent->item->pickup_sound) {
-            gi.sound(other, CHAN_ITEM, gi.soundindex(ent->item->pickup_sound), 1, ATTN_NORM, 0);
+            gi.sound(other, CHAN_ITEM, G_ItemPickupSound(ent->item), 1, ATTN_NORM, 0);
         }
     }
 
@@ -850,7 +858,7 @@ edict_t *Drop_Item(edict_t *ent, gitem_t *item) {
     if (ent->client) {
         trace_t trace;
 
-        AngleVectors(ent->client->v_angle, forward, right, NULL);
+        P_ViewVectors(ent->client, forward, right, NULL);
         VectorSet(offset, 24, 0, -16);
         G_ProjectSource(ent->s.origin, offset, forward, right, dropped->s.origin);
         trace = gi.trace(ent->s.origin, dropped->mins, dropped->maxs,
@@ -954,6 +962,43 @@ void droptofloor(edict_t *ent) {
     gi.linkentity(ent);
 }
 
+/**
+ * Image index of an item's icon. Resolved by PrecacheItem() at level load,
+ * anything that wasn't precached gets looked up once on first use.
+ */
+int G_ItemIcon(const gitem_t *it) {
+    int *index = &level.items.icon[ITEM_INDEX(it)];
+
+    if (!*index && it->icon) {
+        *index = gi.imageindex(it->icon);
+    }
+    return *index;
+}
+
+/**
+ * Sound index of an item's pickup sound, see G_ItemIcon()
+ */
+int G_ItemPickupSound(const gitem_t *it) {
+    int *index = &level.items.pickup_sound[ITEM_INDEX(it)];
+
+    if (!*index && it->pickup_sound) {
+        *index = gi.soundindex(it->pickup_sound);
+    }
+    return *index;
+}
+
+/**
+ * Model index of a weapon's first person model, see G_ItemIcon()
+ */
+int G_ItemViewModel(const gitem_t *it) {
+    int *index = &level.items.view_model[ITEM_INDEX(it)];
+
+    if (!*index && it->view_model) {
+        *index = gi.modelindex(it->view_model);
+    }
+    return *index;
+}
+
 /**
  * Precaches all data needed for a given item.
  *
@@ -963,24 +1008,25 @@ void droptofloor(edict_t *ent) {
 void PrecacheItem(gitem_t *it) {
     char    *s, *start;
     char    data[MAX_QPATH];
-    int     len;
+    int     i, len;
     gitem_t *ammo;
 
     if (!it) {
         return;
     }
 
+    i = ITEM_INDEX(it);
     if (it->pickup_sound) {
-        gi.soundindex(it->pickup_sound);
+        level.items.pickup_sound[i] = gi.soundindex(it->pickup_sound);
     }
     if (it->world_model) {
-        gi.modelindex(it->world_model);
+        level.items.world_model[i] = gi.modelindex(it->world_model);
     }
     if (it->view_model) {
-        gi.modelindex(it->view_model);
+        level.items.view_model[i] = gi.modelindex(it->view_model);
     }
     if (it->icon) {
-        gi.imageindex(it->icon);
+        level.items.icon[i] = gi.imageindex(it->icon);
     }
 
     // parse everything for its ammo
@@ -1061,7 +1107,7 @@ void SpawnItem(edict_t *ent, gitem_t *item) {
         }
     }
     if (DF(INFINITE_AMMO)) {
-        if ((item->flags == IT_AMMO) || (strcmp(ent->classname, "weapon_bfg") == 0)) {
+        if ((item->flags == IT_AMMO) || G_ClassIs(ent, level.classnames.weapon_bfg)) {
             G_FreeEdict(ent);
             return;
         }
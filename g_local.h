@@ -139,6 +139,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #define FL_POWER_ARMOR          0x00001000  // power armor (if any) is active
 #define FL_NOCLIP_PROJECTILE    0x00002000  // projectile hack
 #define FL_MEGAHEALTH           0x00004000  // for megahealth kills tracking
+#define FL_BFG_TARGET           0x00008000  // bfg lasers seek it (not a client or monster)
 #define FL_ACCELERATE           0x20000000  // accelerative movement
 #define FL_HIDDEN               0x40000000  // used for banned items
 #define FL_RESPAWN              0x80000000  // used for item respawning
@@ -487,6 +488,52 @@ typedef struct map_entry_s {
     char    extra_ents[MAX_STRING_CHARS];   // additional entities from <mapname>.ent file
 } map_entry_t;
 
+typedef enum {
+    FRAG_UNKNOWN,
+    FRAG_BLASTER,
+    FRAG_SHOTGUN,
+    FRAG_SUPERSHOTGUN,
+    FRAG_MACHINEGUN,
+    FRAG_CHAINGUN,
+    FRAG_GRENADES,
+    FRAG_GRENADELAUNCHER,
+    FRAG_ROCKETLAUNCHER,
+    FRAG_HYPERBLASTER,
+    FRAG_RAILGUN,
+    FRAG_BFG,
+    FRAG_TELEPORT,
+    FRAG_WATER,
+    FRAG_SLIME,
+    FRAG_LAVA,
+    FRAG_CRUSH,
+    FRAG_FALLING,
+    FRAG_SUICIDE,
+    FRAG_TOTAL
+} frag_t;
+
+typedef struct {
+    int kills;
+    int deaths;
+    int suicides;
+    int hits;
+    int atts;
+} fragstat_t;
+
+typedef struct {
+    int pickups;
+    int misses;
+    int kills;
+} itemstat_t;
+
+// weapon, item and damage counters for one player. Only ints, so rows can
+// be added up as flat arrays, see G_AddStats()
+typedef struct {
+    fragstat_t  frags[FRAG_TOTAL];
+    itemstat_t  items[ITEM_TOTAL];
+    int         damage_given;
+    int         damage_recvd;
+} playerstats_t;
+
 //
 // this structure is cleared as each map is entered
 //
@@ -574,6 +621,29 @@ typedef struct {
         int     impressive;
         int     flawless;
         int     horn;
+
+        // powerups and armor
+        int     power[2];
+        int     damage[3];
+        int     protect[3];
+        int     airout;
+
+        // weapons
+        int     hgrenade_bounce[2];
+        int     hgrenade_tick;
+        int     hgrenade_throw;
+        int     hgrenade_timer;
+        int     grenade_bounce;
+        int     hyperblaster_loop;
+        int     hyperblaster_down;
+        int     chaingun_up;
+        int     chaingun_down;
+        int     chaingun_loop;
+        int     blaster_fly;
+        int     rocket_fly;
+        int     bfg_explode;
+        int     bfg_fly;
+        int     splash;
     } sounds;
 
     struct {
@@ -581,8 +651,42 @@ typedef struct {
         int     skull;
         int     head;
         int     arm, leg, chest, bones[2];
+        int     laser;
+        int     grenade;
+        int     hgrenade;
+        int     rocket;
+        int     bfg;
+        int     bfg_explode;
     } models;
 
+    // interned classnames checked at runtime, see G_InitClassnames()
+    struct {
+        char    *func_areaportal;
+        char    *func_door;
+        char    *func_door_rotating;
+        char    *func_train;
+        char    *grenade;
+        char    *weapon_bfg;
+        char    *misc_explobox;
+    } classnames;
+
+    // entity string load timing, see G_LoadStats()
+    struct {
+        int         entities;
+        int         fields;
+        uint64_t    parse_us;
+        uint64_t    spawn_us;
+        uint64_t    total_us;
+    } load;
+
+    // g_itemlist assets by item index, filled in by PrecacheItem()
+    struct {
+        int     icon[ITEM_TOTAL];
+        int     pickup_sound[ITEM_TOTAL];
+        int     world_model[ITEM_TOTAL];
+        int     view_model[ITEM_TOTAL];
+    } items;
+
     struct {
         int     proposal;
         int     index;
@@ -592,13 +696,30 @@ typedef struct {
         struct gclient_s    *victim;
         struct gclient_s    *initiator;
         char    map[MAX_QPATH];
+        vote_tally_t        tally;
     } vote;
 
+    struct {
+        int         live[MAX_ARENAS];   // FL_NOCLIP_PROJECTILE ents by arena, 0 = world
+        edict_t     *list[MAX_EDICTS];  // the same ents for the broadphase, see g_clip.c
+        int         count;
+        uint32_t    checks;             // G_TouchProjectiles calls
+        uint32_t    skipped;            // calls with nothing live to touch
+        uint32_t    tests;              // box sweeps run instead
+        uint32_t    touches;            // projectiles touched
+    } projectiles;
+
     edict_t     *current_entity;    // entity running from G_RunFrame
     int         body_que;           // dead bodies
 
     arena_t     arenas[MAX_ARENAS];
     int         arena_count;
+
+    // counters for the round being played, row [team][slot] belongs to
+    // arenas[a].teams[team].players[slot], see G_PlayerStats()
+    playerstats_t   round_stats[MAX_ARENAS][MAX_TEAMS][MAX_TEAM_PLAYERS];
+    playerstats_t   team_stats[MAX_ARENAS][MAX_TEAMS];  // finished rounds this match
+
     int         default_arena;
     arena_entry_t arena_defaults[MAX_ARENAS];
     arena_clock_t clock;
@@ -841,6 +962,11 @@ extern  cvar_t  *g_scoremode;   // server level
 extern  cvar_t  *g_debug;
 extern  cvar_t  *g_configlist;
 extern  cvar_t  *g_weapon_hud;
+extern  cvar_t  *g_arena_budget;
+extern  cvar_t  *g_config_cache;
+extern  cvar_t  *g_snapshot_age;
+extern  cvar_t  *g_metrics_socket;
+extern  cvar_t  *g_event_log;
 
 extern  list_t  g_map_list;
 extern  list_t  g_map_queue;
@@ -883,6 +1009,9 @@ void Cmd_Menu_f(edict_t *ent);
 #define INDEX_ITEM(x) ((gitem_t *)&g_itemlist[(x)])
 
 void PrecacheItem(gitem_t *it);
+int G_ItemIcon(const gitem_t *it);
+int G_ItemPickupSound(const gitem_t *it);
+int G_ItemViewModel(const gitem_t *it);
 void InitItems(void);
 void SetItemNames(void);
 gitem_t *FindItem(char *pickup_name);
@@ -905,6 +1034,7 @@ qboolean    G_KillBox(edict_t *ent);
 void    G_ProjectSource(vec3_t point, vec3_t distance, vec3_t forward, vec3_t right, vec3_t result);
 edict_t *G_Find(edict_t *from, size_t fieldofs, char *match);
 edict_t *findradius(edict_t *from, vec3_t org, float rad);
+int G_FindRadius(vec3_t org, float rad, edict_t **list, int maxcount);
 edict_t *G_PickTarget(char *targetname);
 void    G_UseTargets(edict_t *ent, edict_t *activator);
 void    G_SetMovedir(vec3_t angles, vec3_t movedir);
@@ -912,6 +1042,7 @@ void    G_SetMovedir(vec3_t angles, vec3_t movedir);
 void    G_InitEdict(edict_t *e);
 edict_t *G_Spawn(void);
 void    G_FreeEdict(edict_t *e);
+void    G_AddProjectile(edict_t *e, edict_t *owner);
 
 void    G_TouchTriggers(edict_t *ent);
 //void  G_TouchSolids (edict_t *ent);
@@ -921,10 +1052,31 @@ void    G_ShuffleArray(void *base, size_t n);
 size_t  G_HighlightStr(char *dst, const char *src, size_t size);
 
 #define G_Malloc(x) gi.TagMalloc(x, TAG_GAME)
+
+// classname check against a level.classnames entry, the pointers match
+// when both sides were interned
+#define G_ClassIs(e, name)  ((e)->classname == (name) || !strcmp((e)->classname, (name)))
 char    *G_CopyString(const char *in);
 
+typedef struct {
+    uint32_t    chunks;     // TAG_LEVEL blocks grabbed from the server
+    uint32_t    allocs;     // G_LevelAlloc() calls served from them
+    size_t      used;       // bytes handed out
+    size_t      reserved;   // bytes in all chunks
+    uint32_t    interned;       // distinct strings in the intern pool
+    uint32_t    intern_hits;    // lookups that reused an existing copy
+} levelmem_t;
+
+extern  levelmem_t  level_mem;
+
+void    *G_LevelAlloc(size_t size);
+char    *G_InternString(const char *s);
+void    G_FreeLevelMemory(void);
+uint64_t    G_Microseconds(void);
+
 float   *tv(float x, float y, float z);
 char    *vtos(vec3_t v);
+char    *vtos_r(vec3_t v, char *out, size_t size);
 
 float   vectoyaw(vec3_t vec);
 void    vectoangles(vec3_t vec, vec3_t angles);
@@ -1009,12 +1161,31 @@ void G_ServerCommand(void);
 //
 // p_view.c
 //
+typedef struct {
+    uint32_t    hits;       // basis reused, no trig needed
+    uint32_t    misses;     // basis rebuilt with AngleVectors()
+} viewstats_t;
+
+extern  viewstats_t view_stats;
+
 void ClientEndServerFrame(edict_t *ent);
 void IntermissionEndServerFrame(edict_t *ent);
+void P_ViewVectors(gclient_t *client, vec3_t forward, vec3_t right, vec3_t up);
 
 //
 // p_hud.c
 //
+typedef struct {
+    int         last_frame;
+    uint32_t    frames;     // server frames that built stats
+    uint32_t    calls;      // G_SetStats() calls, one per client per frame
+    uint32_t    rebuilds;   // calls that had to rebuild every group
+    uint32_t    writes;     // ps.stats slots written
+    uint32_t    skipped;    // slots left alone because their inputs didn't change
+} hudstats_t;
+
+extern  hudstats_t  hud_stats;
+
 void MoveClientToIntermission(edict_t *client);
 void G_PrivateString(edict_t *ent, int index, const char *string);
 int G_GetPlayerIdView(edict_t *ent, qboolean *teammate);
@@ -1045,6 +1216,7 @@ map_entry_t *G_FindMap(const char *name);
 //
 void G_SpawnEntities(const char *mapname, const char *entities, const char *spawnpoint);
 void G_ResetLevel(void);
+void G_LoadStats(edict_t *ent);
 qboolean G_ParseDamageString(arena_t *a, edict_t *ent, const char **input, uint32_t *target);
 qboolean G_ParseWeaponString(arena_t *arena, edict_t *ent, const char **input, temp_weaponflags_t *t);
 
@@ -1149,6 +1321,8 @@ typedef struct pmenu_entry_s {
 typedef struct pmenu_s {
     int cur;
     pmenu_entry_t entries[MAX_MENU_ENTRIES];
+    int layout;         // shared layout slot, see PMenu_Layout()
+    uint32_t serial;    // slot serial when looked up
 } pmenu_t;
 
 typedef enum {
@@ -1186,43 +1360,6 @@ typedef enum {
     LAYOUT_PLAYERS
 } layout_t;
 
-typedef enum {
-    FRAG_UNKNOWN,
-    FRAG_BLASTER,
-    FRAG_SHOTGUN,
-    FRAG_SUPERSHOTGUN,
-    FRAG_MACHINEGUN,
-    FRAG_CHAINGUN,
-    FRAG_GRENADES,
-    FRAG_GRENADELAUNCHER,
-    FRAG_ROCKETLAUNCHER,
-    FRAG_HYPERBLASTER,
-    FRAG_RAILGUN,
-    FRAG_BFG,
-    FRAG_TELEPORT,
-    FRAG_WATER,
-    FRAG_SLIME,
-    FRAG_LAVA,
-    FRAG_CRUSH,
-    FRAG_FALLING,
-    FRAG_SUICIDE,
-    FRAG_TOTAL
-} frag_t;
-
-typedef struct {
-    int kills;
-    int deaths;
-    int suicides;
-    int hits;
-    int atts;
-} fragstat_t;
-
-typedef struct {
-    int pickups;
-    int misses;
-    int kills;
-} itemstat_t;
-
 #define FLOOD_MSGS  10
 typedef struct flood_s {
     int     locktill;           // locked from talking
@@ -1271,12 +1408,36 @@ typedef struct {
     int         round_score;        // rounds won
     int         match_score;        // matches won
     int         deaths;
-    fragstat_t  frags[FRAG_TOTAL];
-    itemstat_t  items[ITEM_TOTAL];
-    int         damage_given, damage_recvd;
+    playerstats_t   stats;      // finished rounds, see G_ClientStats()
     int         points;     // 1 for every 100 damage_given
 } client_respawn_t;
 
+// per client counters for lag hunting, see G_ClientPerfFrame()
+#define PERF_WINDOW         (10 * HZ)   // frames per rolling window
+#define PERF_THINKS         5           // 0..3 and more ClientThink calls per frame
+#define PERF_MSECS          6           // usercmd msec histogram buckets
+
+typedef struct {
+    uint32_t    frames;             // server frames in this window
+    uint32_t    thinks;             // ClientThink calls
+    uint32_t    think_frames[PERF_THINKS];  // frames by number of calls
+    uint32_t    msecs[PERF_MSECS];  // usercmds by msec
+    uint32_t    pmoves;
+    uint64_t    pmove_usec;
+    uint32_t    pmove_max;          // slowest single pmove, usec
+    uint32_t    reliable_msgs;      // unicast by the game module
+    uint32_t    reliable_bytes;
+    uint32_t    unreliable_bytes;
+    uint32_t    layouts;            // svc_layout messages
+    uint32_t    configstrings;      // private and broadcast configstrings
+} perfwindow_t;
+
+typedef struct {
+    int             frame_thinks;   // ClientThink calls since the last frame
+    perfwindow_t    cur;            // window being filled
+    perfwindow_t    last;           // last complete window
+} clientperf_t;
+
 // client data that stays across respawns,
 // but cleared on level changes
 typedef struct {
@@ -1290,8 +1451,41 @@ typedef struct {
         int         count;
     } vote;
     flood_t     chat_flood, wave_flood, info_flood;
+    clientperf_t    perf;
 } client_level_t;
 
+// groups of stats G_SetStats() can skip when their inputs didn't change
+#define STATS_HEALTH    BIT(0)
+#define STATS_AMMO      BIT(1)
+#define STATS_ARMOR     BIT(2)
+#define STATS_TIMER     BIT(3)
+#define STATS_SELECTED  BIT(4)
+#define STATS_SCORE     BIT(5)
+#define STATS_ROUND     BIT(6)
+#define STATS_AMMOHUD   BIT(7)
+#define STATS_ALL       (BIT(8) - 1)
+
+// what G_SetStats() last built a client's stats from
+typedef struct {
+    qboolean        valid;
+    short           stats[MAX_STATS];   // ps.stats as G_SetStats() left them
+    int             health;
+    int             ammo_index;
+    int             ammo;
+    const gitem_t   *weapon;
+    int             power_armor;
+    int             armor_index;
+    int             armor;
+    qboolean        timer;
+    int             selected_item;
+    int             score;
+    qboolean        vote;
+    int             ready;
+    qboolean        team;
+    int             ammohud[5];         // ITEM_SHELLS .. ITEM_SLUGS
+    int             grenades;
+} statcache_t;
+
 // this structure is cleared on each PutClientInServer(),
 // except for 'client->pers'
 struct gclient_s {
@@ -1346,6 +1540,11 @@ struct gclient_s {
     float       bonus_alpha;
     vec3_t      damage_blend;
     vec3_t      v_angle;            // aiming direction
+    vec3_t      v_forward;          // basis cached from v_angle,
+    vec3_t      v_right;            // see P_ViewVectors()
+    vec3_t      v_up;
+    vec3_t      v_basis_angle;      // v_angle the basis was built from
+    qboolean    v_basis_valid;
     float       bobtime;            // so off-ground doesn't change it
     vec3_t      oldviewangles;
     vec3_t      oldvelocity;
@@ -1395,6 +1594,8 @@ struct gclient_s {
 
     gitem_t     *weapon;
     gitem_t     *lastweapon;
+
+    statcache_t statcache;          // see G_SetStats()
 };
 
 
@@ -1576,12 +1777,34 @@ void UpdateChaseTargets(chase_mode_t mode, edict_t *targ);
 qboolean ValidChaseTarget(edict_t *ent, edict_t *targ);
 void ChaseTeamMate(edict_t *ent);
 
+//
+// g_clip.c
+//
+#define CLIP_PLAYERS        1
+#define CLIP_PROJECTILES    2
+
+typedef struct {
+    edict_t     *ent;
+    float       fraction;
+    vec3_t      endpos;
+    vec3_t      normal;
+} clip_hit_t;
+
+qboolean G_RayBox(vec3_t start, vec3_t delta, vec3_t mins, vec3_t maxs, float *frac, vec3_t normal);
+void G_ClipLink(edict_t *e);
+void G_ClipUnlink(edict_t *e);
+int G_ClipBoxes(vec3_t mins, vec3_t maxs, int mask, edict_t **list, int maxcount);
+int G_ClipMove(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t end,
+        edict_t *passent, int mask, clip_hit_t *hits, int maxhits);
+
 //
 // g_vote.c
 //
 void G_FinishVote(void);
 void G_UpdateVote(void);
 qboolean G_CheckVote(void);
+void G_UpdateVoteTally(gclient_t *c);
+void G_RebuildVoteTally(void);
 void Cmd_Vote_f(edict_t *ent);
 void Cmd_CastVote_f(edict_t *ent, qboolean accepted);
 uint8_t damage_vote_index(const char *name);
@@ -1604,6 +1827,116 @@ void G_RemoveIP_f(edict_t *ent);
 void G_ListIP_f(edict_t *ent);
 void G_WriteIP_f(void);
 
+//
+// g_cache.c
+//
+
+typedef enum {
+    CACHE_MAPLIST,      // g_maps_file, map names
+    CACHE_SKINLIST,     // g_skins_file, directories and skin names
+    CACHE_MAPCFG,       // mapcfg/<map>.cfg, arena count and arena_entry_t's
+    CACHE_TOTAL
+} cache_type_t;
+
+typedef struct {
+    uint32_t    records;    // parsed files held in memory
+    uint32_t    hits;       // loads served from a record
+    uint32_t    misses;     // loads that went to the text parser
+    uint32_t    writes;     // snapshots written to disk
+} cache_stats_t;
+
+typedef struct {
+    byte        *data;
+    size_t      len;
+    size_t      size;
+} cache_blob_t;
+
+extern cache_stats_t cache_stats;
+
+void G_LoadConfigCache(void);
+void G_SaveConfigCache(void);
+void G_FreeConfigCache(void);
+void G_InvalidateConfigCache(void);
+const void *G_CacheFind(cache_type_t type, const char *path, size_t *len);
+void G_CacheStore(cache_type_t type, const char *path, const void *data, size_t len);
+uint32_t G_CacheChecksum(const void *data, size_t len);
+void G_BlobAppend(cache_blob_t *b, const void *data, size_t len);
+void G_BlobFree(cache_blob_t *b);
+
+//
+// g_metrics.c
+//
+#define METRICS_BUCKETS     8
+
+typedef struct {
+    uint64_t    frame_buckets[METRICS_BUCKETS + 1];
+    uint64_t    frame_count;
+    uint64_t    frame_usec;
+    uint32_t    scrapes;
+} metrics_t;
+
+extern metrics_t metrics;
+
+void G_MetricsFrame(uint64_t usec);
+void G_MetricsPrintf(cache_blob_t *b, const char *fmt, ...) q_printf(2, 3);
+char *G_MetricsLabel(const char *s);
+void G_BuildMetrics(cache_blob_t *b);
+void G_RunMetrics(void);
+void G_CloseMetrics(void);
+void G_HookMessages(void);
+void G_ClientPerfFrame(void);
+void G_ClientPerfThink(gclient_t *client, int msec);
+void G_ClientPerfPmove(gclient_t *client, uint64_t usec);
+const perfwindow_t *G_ClientPerfWindow(gclient_t *client);
+void G_PrintClientPerf(gclient_t *client);
+
+//
+// g_events.c
+//
+typedef struct {
+    uint32_t    files;      // logs opened
+    uint32_t    events;     // events recorded
+    uint32_t    flushes;    // buffer writes
+    uint64_t    bytes;      // bytes written
+} events_stats_t;
+
+extern events_stats_t events_stats;
+
+void G_OpenEventLog(const char *mapname);
+void G_CloseEventLog(void);
+void G_FlushEvents(void);
+void G_LogClientEvent(edict_t *ent);
+void G_LogRoundStart(arena_t *a);
+void G_LogRoundEnd(arena_t *a);
+void G_LogMatchEnd(arena_t *a, arena_team_t *winner);
+void G_LogDamage(edict_t *targ, edict_t *attacker, int points);
+void G_LogKill(edict_t *self, edict_t *attacker);
+void G_LogPickup(edict_t *ent, int item);
+
+//
+// g_save.c
+//
+qboolean G_WriteSnapshot(const char *filename);
+qboolean G_ReadSnapshot(const char *filename, const char *mapname);
+void G_FreeSnapshot(void);
+void G_ClearSnapshot(void);
+void G_ShutdownSnapshot(void);
+void G_SpawnSnapshot(const char *mapname);
+void G_RestoreClient(edict_t *ent);
+void G_ResumeArena(arena_t *a);
+
+//
+// g_stats.c
+//
+playerstats_t *G_FindPlayerStats(edict_t *ent);
+playerstats_t *G_PlayerStats(edict_t *ent);
+void G_ClientStats(gclient_t *c, playerstats_t *out);
+void G_TeamStats(arena_t *a, arena_team_t *team, playerstats_t *out);
+int G_StatsAccuracy(const playerstats_t *s);
+void G_FoldPlayerStats(edict_t *ent);
+void G_FoldRoundStats(arena_t *a);
+void G_ClearArenaStats(arena_t *a);
+
 //
 // g_sqlite.c
 //
@@ -143,6 +143,11 @@ cvar_t *g_scoremode;
 cvar_t *g_debug;
 cvar_t *g_configlist;
 cvar_t *g_weapon_hud;
+cvar_t *g_arena_budget;
+cvar_t *g_config_cache;
+cvar_t *g_snapshot_age;
+cvar_t *g_metrics_socket;
+cvar_t *g_event_log;
 
 LIST_DECL(g_map_list);
 LIST_DECL(g_map_queue);
@@ -500,6 +505,18 @@ static void G_PickNextMap(void) {
     strcpy(level.nextmap, map->name);
 }
 
+/**
+ *
+ */
+static void G_AddMap(const char *name, size_t len) {
+    map_entry_t *map;
+
+    map = G_Malloc(sizeof(*map) + len);
+    memcpy(map->name, name, len + 1);
+
+    List_Append(&g_map_list, &map->list);
+}
+
 /**
  * Read the map list file. These maps will be voteable in-game.
  */
@@ -508,7 +525,7 @@ static void G_LoadMapList(void) {
     char        buffer[MAX_STRING_CHARS];
     char        *token;
     const char  *data;
-    map_entry_t *map;
+    cache_blob_t blob;
     FILE        *fp;
     size_t      len;
     int         linenum,
@@ -523,12 +540,26 @@ static void G_LoadMapList(void) {
         return;
     }
 
+    // snapshot holds the accepted names, each 0 terminated
+    data = G_CacheFind(CACHE_MAPLIST, path, &len);
+    if (data && (!len || !data[len - 1])) {
+        const char *end = data + len;
+
+        while (data < end) {
+            len = strlen(data);
+            G_AddMap(data, len);
+            data += len + 1;
+        }
+        return;
+    }
+
     fp = fopen(path, "r");
     if (!fp) {
         gi.cprintf(NULL, PRINT_HIGH, "Couldn't load '%s'...\n", path);
         return;
     }
 
+    memset(&blob, 0, sizeof(blob));
     linenum = nummaps = 0;
 
     while (qtrue) {
@@ -554,14 +585,44 @@ static void G_LoadMapList(void) {
             continue;
         }
 
-        map = G_Malloc(sizeof(*map) + len);
-        memcpy(map->name, token, len + 1);
-
-        List_Append(&g_map_list, &map->list);
+        G_AddMap(token, len);
+        G_BlobAppend(&blob, token, len + 1);
         nummaps++;
     }
 
     fclose(fp);
+
+    G_CacheStore(CACHE_MAPLIST, path, blob.data, blob.len);
+    G_BlobFree(&blob);
+}
+
+/**
+ * A name ending in a slash starts a new skin directory, anything else is a
+ * skin in the most recent one.
+ *
+ * Returns qfalse for a skin that came before any directory.
+ */
+static qboolean G_AddSkin(const char *name, size_t len, int *numskins, int *numdirs) {
+    skin_entry_t *skin;
+
+    if (name[len - 1] != '/' && !game.skins) {
+        return qfalse;
+    }
+
+    skin = G_Malloc(sizeof(*skin) + len);
+    memcpy(skin->name, name, len + 1);
+
+    if (name[len - 1] == '/') {
+        skin->name[len - 1] = 0;
+        skin->next = game.skins;
+        game.skins = skin;
+        (*numdirs)++;
+    } else {
+        skin->next = game.skins->down;
+        game.skins->down = skin;
+        (*numskins)++;
+    }
+    return qtrue;
 }
 
 /**
@@ -572,7 +633,7 @@ static void G_LoadSkinList(void) {
     char         buffer[MAX_STRING_CHARS];
     char         *token;
     const char   *data;
-    skin_entry_t *skin;
+    cache_blob_t blob;
     FILE         *fp;
     size_t       len;
     int          linenum,
@@ -589,13 +650,33 @@ static void G_LoadSkinList(void) {
         return;
     }
 
+    numskins = numdirs = 0;
+
+    // snapshot holds the accepted tokens in file order, each 0 terminated
+    data = G_CacheFind(CACHE_SKINLIST, path, &len);
+    if (data && (!len || !data[len - 1])) {
+        const char *end = data + len;
+
+        while (data < end) {
+            len = strlen(data);
+            if (len) {
+                G_AddSkin(data, len, &numskins, &numdirs);
+            }
+            data += len + 1;
+        }
+        gi.cprintf(NULL, PRINT_HIGH, "Loaded %d skins in %d dirs from '%s' (cached)\n",
+                numskins, numdirs, path);
+        return;
+    }
+
     fp = fopen(path, "r");
     if (!fp) {
         gi.dprintf("Couldn't load '%s'\n", path);
         return;
     }
 
-    linenum = numskins = numdirs = 0;
+    memset(&blob, 0, sizeof(blob));
+    linenum = 0;
     while (1) {
         data = fgets(buffer, sizeof(buffer), fp);
         if (!data) {
@@ -619,18 +700,8 @@ static void G_LoadSkinList(void) {
             continue;
         }
 
-        skin = G_Malloc(sizeof(*skin) + len);
-        memcpy(skin->name, token, len + 1);
-
-        if (token[len - 1] == '/') {
-            skin->name[len - 1] = 0;
-            skin->next = game.skins;
-            game.skins = skin;
-            numdirs++;
-        } else if (game.skins) {
-            skin->next = game.skins->down;
-            game.skins->down = skin;
-            numskins++;
+        if (G_AddSkin(token, len, &numskins, &numdirs)) {
+            G_BlobAppend(&blob, token, len + 1);
         } else {
             gi.cprintf(NULL, PRINT_HIGH, "%s: skinname before directory at line %d\n", __func__,
                     linenum);
@@ -639,6 +710,9 @@ static void G_LoadSkinList(void) {
 
     fclose(fp);
 
+    G_CacheStore(CACHE_SKINLIST, path, blob.data, blob.len);
+    G_BlobFree(&blob);
+
     gi.cprintf(NULL, PRINT_HIGH, "Loaded %d skins in %d dirs from '%s'\n", numskins, numdirs,
             path);
 }
@@ -697,6 +771,7 @@ static void G_CheckRules(void) {
     }
 
     if (g_vote_flags->modified) {
+        G_RebuildVoteTally();
         G_CheckVote();
         g_vote_flags->modified = qfalse;
     }
@@ -755,6 +830,7 @@ void G_RunFrame(void) {
     int     i;
     edict_t *ent;
     arena_t *a;
+    uint64_t start = G_Microseconds();
 
     // Treat each object in turn, even the world gets a chance to think
     for (i = 0, ent = g_edicts; i < globals.num_edicts; i++, ent++) {
@@ -785,6 +861,9 @@ void G_RunFrame(void) {
         G_ArenaThink(a);
     }
 
+    // scoreboards, status bars, etc that arenas queued up
+    G_RunArenaWork();
+
     // check vote timeout
     if (level.vote.proposal) {
         G_UpdateVote();
@@ -814,6 +893,10 @@ void G_RunFrame(void) {
     if (level.clock.tick) {
         level.clock.tick(&level.clock);
     }
+
+    G_ClientPerfFrame();
+    G_MetricsFrame(G_Microseconds() - start);
+    G_RunMetrics();
 }
 
 /**
@@ -829,7 +912,12 @@ static void G_Shutdown(void) {
     G_CloseDatabase();
 #endif
 
-    gi.FreeTags(TAG_LEVEL);
+    G_ShutdownSnapshot();
+    G_CloseMetrics();
+    G_CloseEventLog();
+    G_FreeLevelMemory();
+    G_FlushMapSettings();
+    G_FreeConfigCache();
     gi.FreeTags(TAG_GAME);
 
     memset(&game, 0, sizeof(game));
@@ -1065,6 +1153,12 @@ static void G_Init(void) {
     g_debug = gi.cvar("g_debug", "0", CVAR_GENERAL);
     g_configlist = gi.cvar("g_configlist", "", CVAR_LATCH);
     g_weapon_hud = gi.cvar("g_weapon_hud", va("%d", HUD_ENABLED), CVAR_GENERAL);
+    g_arena_budget = gi.cvar("g_arena_budget", "32", CVAR_GENERAL);
+    g_config_cache = gi.cvar("g_config_cache", "1", CVAR_LATCH);
+    g_snapshot_age = gi.cvar("g_snapshot_age", "300", 0);
+    g_metrics_socket = gi.cvar("g_metrics_socket", "", 0);
+    g_metrics_socket->modified = qtrue;     // (re)open it on this game instance
+    g_event_log = gi.cvar("g_event_log", "0", 0);
 
     // Sane limits
     clamp(g_round_countdown->value, 3, 30);
@@ -1118,6 +1212,8 @@ static void G_Init(void) {
         game.dir[0] = 0;
     }
 
+    G_LoadConfigCache();
+
     check_cvar(g_maps_file);
     if (g_maps_file->string[0]) {
         G_LoadMapList();
@@ -1134,6 +1230,8 @@ static void G_Init(void) {
         G_LoadSkinList();
     }
 
+    G_SaveConfigCache();
+
     // obtain server features
     cv = gi.cvar("sv_features", NULL, 0);
     if (cv) {
@@ -1172,8 +1270,18 @@ static void G_Init(void) {
     gi.cprintf(NULL, PRINT_HIGH, "==== Game Initialized ====\n\n");
 }
 
-static void G_WriteGame(const char *filename, qboolean autosave) {}
-static void G_ReadGame(const char *filename) {}
+/**
+ * Savegames carry the same arena snapshot that is kept across restarts
+ */
+static void G_WriteGame(const char *filename, qboolean autosave) {
+    G_WriteSnapshot(filename);
+}
+
+static void G_ReadGame(const char *filename) {
+    G_ReadSnapshot(filename, NULL);
+}
+
+// entities are respawned from the map, there is no per-level state to keep
 static void G_WriteLevel(const char *filename) {}
 static void G_ReadLevel(const char *filename) {}
 
@@ -1216,6 +1324,7 @@ void Com_Error(error_type_t code, const char *error, ...) {
  */
 q_exported game_export_t *GetGameAPI(game_import_t *import) {
     gi = *import;
+    G_HookMessages();
 
     globals.apiversion = GAME_API_VERSION;
     globals.Init = G_Init;
@@ -0,0 +1,708 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_metrics.c -- stats dump for scrapers over a local socket
+
+#include "g_local.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL    0
+#endif
+#endif
+
+/**
+ * When g_metrics_socket names a path, a non-blocking unix stream socket is
+ * opened there. Every connection gets one Prometheus style text dump and
+ * is closed. Everything happens from G_RunMetrics() once per frame, with
+ * no blocking calls, so a scraper can never stall the server. Without the
+ * cvar set nothing here runs at all.
+ *
+ * The same dump is printed by 'sv metrics'.
+ */
+#define METRICS_CONNS       4
+#define METRICS_TIMEOUT     5000000     // usec before a slow reader is dropped
+
+// frame time histogram bounds in usec
+static const uint32_t frame_buckets[METRICS_BUCKETS] = {
+    250, 500, 1000, 2000, 4000, 8000, 16000, 32000
+};
+
+// usercmd msec histogram bounds
+static const int perf_msecs[PERF_MSECS - 1] = { 5, 10, 20, 50, 100 };
+
+metrics_t metrics;
+
+// engine functions wrapped by G_HookMessages()
+static game_import_t engine;
+
+// the message being built for the next unicast
+static struct {
+    size_t      bytes;
+    int         type;
+} perf_msg;
+
+#ifndef _WIN32
+typedef struct {
+    qboolean        active;
+    int             fd;
+    cache_blob_t    out;
+    size_t          sent;
+    uint64_t        opened;
+} metrics_conn_t;
+
+static int              metrics_fd = -1;
+static metrics_conn_t   metrics_conns[METRICS_CONNS];
+static char             metrics_path[MAX_OSPATH];
+#endif
+
+/**
+ * Count one G_RunFrame() that took usec
+ */
+void G_MetricsFrame(uint64_t usec) {
+    int i;
+
+    for (i = 0; i < METRICS_BUCKETS; i++) {
+        if (usec <= frame_buckets[i]) {
+            break;
+        }
+    }
+    metrics.frame_buckets[i]++;
+    metrics.frame_count++;
+    metrics.frame_usec += usec;
+}
+
+/**
+ * Close the frame for every client's counters, rolling over to a new window
+ * every PERF_WINDOW frames. ClientThink runs between server frames, so the
+ * calls counted here are the ones since the previous frame.
+ */
+void G_ClientPerfFrame(void) {
+    clientperf_t *perf;
+    gclient_t *cl;
+    int i;
+
+    for (i = 0, cl = game.clients; i < game.maxclients; i++, cl++) {
+        if (cl->pers.connected == CONN_DISCONNECTED) {
+            continue;
+        }
+        perf = &cl->level.perf;
+        perf->cur.frames++;
+        perf->cur.think_frames[min(perf->frame_thinks, PERF_THINKS - 1)]++;
+        perf->frame_thinks = 0;
+
+        if (perf->cur.frames >= PERF_WINDOW) {
+            perf->last = perf->cur;
+            memset(&perf->cur, 0, sizeof(perf->cur));
+        }
+    }
+}
+
+/**
+ * Count one ClientThink call carrying a usercmd of msec
+ */
+void G_ClientPerfThink(gclient_t *client, int msec) {
+    clientperf_t *perf = &client->level.perf;
+    int i;
+
+    for (i = 0; i < PERF_MSECS - 1; i++) {
+        if (msec <= perf_msecs[i]) {
+            break;
+        }
+    }
+    perf->cur.msecs[i]++;
+    perf->cur.thinks++;
+    perf->frame_thinks++;
+}
+
+/**
+ *
+ */
+void G_ClientPerfPmove(gclient_t *client, uint64_t usec) {
+    perfwindow_t *w = &client->level.perf.cur;
+
+    w->pmoves++;
+    w->pmove_usec += usec;
+    w->pmove_max = max(w->pmove_max, (uint32_t)usec);
+}
+
+/**
+ * The last complete window, or the one being filled if there isn't one yet
+ */
+const perfwindow_t *G_ClientPerfWindow(gclient_t *client) {
+    clientperf_t *perf = &client->level.perf;
+
+    return perf->last.frames ? &perf->last : &perf->cur;
+}
+
+/**
+ * 'sv clientperf' output
+ */
+void G_PrintClientPerf(gclient_t *client) {
+    const perfwindow_t *w = G_ClientPerfWindow(client);
+    int i;
+
+    Com_Printf("%d %s, last %.1f seconds:\n", (int)(client - game.clients),
+               client->pers.netname, w->frames * FRAMETIME);
+    Com_Printf("  ClientThink: %u calls, %.2f per frame\n", w->thinks,
+               w->frames ? (float)w->thinks / w->frames : 0);
+    Com_Printf("  frames by calls:");
+    for (i = 0; i < PERF_THINKS; i++) {
+        Com_Printf(" %d%s: %u", i, i == PERF_THINKS - 1 ? "+" : "", w->think_frames[i]);
+    }
+    Com_Printf("\n");
+    Com_Printf("  pmove: %"PRIu64" usec avg, %u usec max\n",
+               w->pmoves ? w->pmove_usec / w->pmoves : 0, w->pmove_max);
+    Com_Printf("  usercmd msec:");
+    for (i = 0; i < PERF_MSECS - 1; i++) {
+        Com_Printf(" <=%d: %u", perf_msecs[i], w->msecs[i]);
+    }
+    Com_Printf(" more: %u\n", w->msecs[i]);
+    Com_Printf("  reliable: %u messages, %u bytes\n", w->reliable_msgs, w->reliable_bytes);
+    Com_Printf("  unreliable: %u bytes\n", w->unreliable_bytes);
+    Com_Printf("  layouts: %u, configstrings: %u\n", w->layouts, w->configstrings);
+}
+
+/**
+ * Message writes are counted on the way to the engine so a unicast can be
+ * charged to its client. Sizes are what protocol 34 uses, extended
+ * protocols may encode positions differently.
+ */
+static void G_CountWrite(int type, size_t bytes) {
+    if (!perf_msg.bytes) {
+        perf_msg.type = type;
+    }
+    perf_msg.bytes += bytes;
+}
+
+static void Perf_WriteChar(int c) {
+    G_CountWrite(-1, 1);
+    engine.WriteChar(c);
+}
+
+static void Perf_WriteByte(int c) {
+    G_CountWrite(c, 1);
+    engine.WriteByte(c);
+}
+
+static void Perf_WriteShort(int c) {
+    G_CountWrite(-1, 2);
+    engine.WriteShort(c);
+}
+
+static void Perf_WriteLong(int c) {
+    G_CountWrite(-1, 4);
+    engine.WriteLong(c);
+}
+
+static void Perf_WriteFloat(float f) {
+    G_CountWrite(-1, 4);
+    engine.WriteFloat(f);
+}
+
+static void Perf_WriteString(const char *s) {
+    G_CountWrite(-1, (s ? strlen(s) : 0) + 1);
+    engine.WriteString(s);
+}
+
+static void Perf_WritePosition(const vec3_t pos) {
+    G_CountWrite(-1, 6);
+    engine.WritePosition(pos);
+}
+
+static void Perf_WriteDir(const vec3_t dir) {
+    G_CountWrite(-1, 1);
+    engine.WriteDir(dir);
+}
+
+static void Perf_WriteAngle(float f) {
+    G_CountWrite(-1, 1);
+    engine.WriteAngle(f);
+}
+
+static void Perf_unicast(edict_t *ent, qboolean reliable) {
+    perfwindow_t *w;
+    int num = ent ? ent - g_edicts : 0;
+
+    if (num > 0 && num <= game.maxclients && ent->client) {
+        w = &ent->client->level.perf.cur;
+        if (reliable) {
+            w->reliable_msgs++;
+            w->reliable_bytes += perf_msg.bytes;
+        } else {
+            w->unreliable_bytes += perf_msg.bytes;
+        }
+        if (perf_msg.type == SVC_LAYOUT) {
+            w->layouts++;
+        } else if (perf_msg.type == SVC_CONFIGSTRING) {
+            w->configstrings++;
+        }
+    }
+    perf_msg.bytes = 0;
+    engine.unicast(ent, reliable);
+}
+
+static void Perf_multicast(vec3_t origin, multicast_t to) {
+    perf_msg.bytes = 0;
+    engine.multicast(origin, to);
+}
+
+// the engine sends these reliably to everyone
+static void Perf_configstring(int num, const char *string) {
+    perfwindow_t *w;
+    gclient_t *cl;
+    int i;
+
+    for (i = 0, cl = game.clients; cl && i < game.maxclients; i++, cl++) {
+        if (cl->pers.connected == CONN_DISCONNECTED) {
+            continue;
+        }
+        w = &cl->level.perf.cur;
+        w->reliable_msgs++;
+        w->reliable_bytes += 4 + (string ? strlen(string) : 0);
+        w->configstrings++;
+    }
+    engine.configstring(num, string);
+}
+
+/**
+ * Route message output through the counters above, called once the import
+ * table is copied in GetGameAPI()
+ */
+void G_HookMessages(void) {
+    engine = gi;
+    gi.WriteChar = Perf_WriteChar;
+    gi.WriteByte = Perf_WriteByte;
+    gi.WriteShort = Perf_WriteShort;
+    gi.WriteLong = Perf_WriteLong;
+    gi.WriteFloat = Perf_WriteFloat;
+    gi.WriteString = Perf_WriteString;
+    gi.WritePosition = Perf_WritePosition;
+    gi.WriteDir = Perf_WriteDir;
+    gi.WriteAngle = Perf_WriteAngle;
+    gi.unicast = Perf_unicast;
+    gi.multicast = Perf_multicast;
+    gi.configstring = Perf_configstring;
+}
+
+/**
+ *
+ */
+void G_MetricsPrintf(cache_blob_t *b, const char *fmt, ...) {
+    char buffer[MAX_STRING_CHARS];
+    va_list argptr;
+    size_t len;
+
+    va_start(argptr, fmt);
+    len = Q_vsnprintf(buffer, sizeof(buffer), fmt, argptr);
+    va_end(argptr);
+
+    G_BlobAppend(b, buffer, min(len, sizeof(buffer) - 1));
+}
+
+/**
+ * Names go inside quoted labels, keep them printable and unquoted
+ */
+char *G_MetricsLabel(const char *s) {
+    static char buffer[MAX_QPATH];
+    size_t i;
+
+    for (i = 0; *s && i < sizeof(buffer) - 1; s++) {
+        int c = *s & 127;
+        if (c < 32 || c == '"' || c == '\\') {
+            continue;
+        }
+        buffer[i++] = c;
+    }
+    buffer[i] = 0;
+    return buffer;
+}
+
+typedef enum {
+    PERF_THINKS_PER_FRAME,
+    PERF_PMOVE_AVG,
+    PERF_PMOVE_MAX,
+    PERF_USERCMDS,
+    PERF_RELIABLE_BYTES,
+    PERF_UNRELIABLE_BYTES,
+    PERF_LAYOUTS,
+    PERF_CONFIGSTRINGS
+} perf_metric_t;
+
+/**
+ * One line per connected client for a per client metric
+ */
+static void G_ClientPerfMetrics(cache_blob_t *b, const char *name, perf_metric_t metric) {
+    const perfwindow_t *w;
+    char labels[MAX_QPATH * 2];
+    gclient_t *cl;
+    int i, j;
+
+    for (i = 0, cl = game.clients; i < game.maxclients; i++, cl++) {
+        if (cl->pers.connected == CONN_DISCONNECTED) {
+            continue;
+        }
+        w = G_ClientPerfWindow(cl);
+        Q_snprintf(labels, sizeof(labels), "client=\"%d\",name=\"%s\"",
+                   i, G_MetricsLabel(cl->pers.netname));
+
+        switch (metric) {
+        case PERF_THINKS_PER_FRAME:
+            G_MetricsPrintf(b, "%s{%s} %g\n", name, labels,
+                            w->frames ? (double)w->thinks / w->frames : 0);
+            break;
+        case PERF_PMOVE_AVG:
+            G_MetricsPrintf(b, "%s{%s} %g\n", name, labels,
+                            w->pmoves ? w->pmove_usec / 1e6 / w->pmoves : 0);
+            break;
+        case PERF_PMOVE_MAX:
+            G_MetricsPrintf(b, "%s{%s} %g\n", name, labels, w->pmove_max / 1e6);
+            break;
+        case PERF_USERCMDS:
+            for (j = 0; j < PERF_MSECS - 1; j++) {
+                G_MetricsPrintf(b, "%s{%s,msec=\"%d\"} %u\n", name, labels,
+                                perf_msecs[j], w->msecs[j]);
+            }
+            G_MetricsPrintf(b, "%s{%s,msec=\"more\"} %u\n", name, labels, w->msecs[j]);
+            break;
+        case PERF_RELIABLE_BYTES:
+            G_MetricsPrintf(b, "%s{%s} %u\n", name, labels, w->reliable_bytes);
+            break;
+        case PERF_UNRELIABLE_BYTES:
+            G_MetricsPrintf(b, "%s{%s} %u\n", name, labels, w->unreliable_bytes);
+            break;
+        case PERF_LAYOUTS:
+            G_MetricsPrintf(b, "%s{%s} %u\n", name, labels, w->layouts);
+            break;
+        case PERF_CONFIGSTRINGS:
+            G_MetricsPrintf(b, "%s{%s} %u\n", name, labels, w->configstrings);
+            break;
+        }
+    }
+}
+
+/**
+ * Write the whole dump into b
+ */
+void G_BuildMetrics(cache_blob_t *b) {
+    int i, used, conns[CONN_SPECTATOR + 1];
+    uint64_t total;
+    gclient_t *cl;
+    arena_t *a;
+
+    G_MetricsPrintf(b, "# HELP openra2_frame_seconds Time spent in G_RunFrame.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_frame_seconds histogram\n");
+    total = 0;
+    for (i = 0; i < METRICS_BUCKETS; i++) {
+        total += metrics.frame_buckets[i];
+        G_MetricsPrintf(b, "openra2_frame_seconds_bucket{le=\"%g\"} %"PRIu64"\n",
+                        frame_buckets[i] / 1e6, total);
+    }
+    G_MetricsPrintf(b, "openra2_frame_seconds_bucket{le=\"+Inf\"} %"PRIu64"\n", metrics.frame_count);
+    G_MetricsPrintf(b, "openra2_frame_seconds_sum %g\n", metrics.frame_usec / 1e6);
+    G_MetricsPrintf(b, "openra2_frame_seconds_count %"PRIu64"\n", metrics.frame_count);
+
+    G_MetricsPrintf(b, "# TYPE openra2_level_frames counter\n");
+    G_MetricsPrintf(b, "openra2_level_frames{map=\"%s\"} %d\n",
+                    G_MetricsLabel(level.mapname), level.framenum);
+
+    used = 0;
+    for (i = 0; i < globals.num_edicts; i++) {
+        if (g_edicts[i].inuse) {
+            used++;
+        }
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_edicts gauge\n");
+    G_MetricsPrintf(b, "openra2_edicts{state=\"inuse\"} %d\n", used);
+    G_MetricsPrintf(b, "openra2_edicts{state=\"allocated\"} %d\n", globals.num_edicts);
+    G_MetricsPrintf(b, "openra2_edicts{state=\"max\"} %d\n", game.maxentities);
+
+    memset(conns, 0, sizeof(conns));
+    for (i = 0; i < game.maxclients; i++) {
+        cl = &game.clients[i];
+        if (cl->pers.connected >= CONN_DISCONNECTED && cl->pers.connected <= CONN_SPECTATOR) {
+            conns[cl->pers.connected]++;
+        }
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_clients gauge\n");
+    G_MetricsPrintf(b, "openra2_clients{state=\"connected\"} %d\n", conns[CONN_CONNECTED]);
+    G_MetricsPrintf(b, "openra2_clients{state=\"pregame\"} %d\n", conns[CONN_PREGAME]);
+    G_MetricsPrintf(b, "openra2_clients{state=\"spawned\"} %d\n", conns[CONN_SPAWNED]);
+    G_MetricsPrintf(b, "openra2_clients{state=\"spectator\"} %d\n", conns[CONN_SPECTATOR]);
+
+    G_MetricsPrintf(b, "# TYPE openra2_arena_clients gauge\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_clients{arena=\"%d\",name=\"%s\"} %d\n",
+                        a->number, G_MetricsLabel(a->name), a->client_count);
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_arena_players gauge\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_players{arena=\"%d\"} %d\n", a->number, a->player_count);
+    }
+    G_MetricsPrintf(b, "# HELP openra2_arena_state Arena state, 0 warmup to 6 match intermission.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_arena_state gauge\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_state{arena=\"%d\"} %d\n", a->number, a->state);
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_arena_round gauge\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_round{arena=\"%d\"} %d\n", a->number, a->current_round);
+    }
+    G_MetricsPrintf(b, "# HELP openra2_arena_multicast_bytes_total Effect bytes unicast to arena members.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_arena_multicast_bytes_total counter\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_multicast_bytes_total{arena=\"%d\"} %u\n",
+                        a->number, a->multicast.bytes);
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_arena_multicast_sends_total counter\n");
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_arena_multicast_sends_total{arena=\"%d\"} %u\n",
+                        a->number, a->multicast.sends);
+    }
+
+    G_MetricsPrintf(b, "# HELP openra2_vote_active Vote running, arena 0 is the server wide one.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_vote_active gauge\n");
+    G_MetricsPrintf(b, "openra2_vote_active{arena=\"0\"} %d\n", level.vote.proposal ? 1 : 0);
+    FOR_EACH_ARENA(a) {
+        G_MetricsPrintf(b, "openra2_vote_active{arena=\"%d\"} %d\n", a->number, a->vote.proposal ? 1 : 0);
+    }
+    G_MetricsPrintf(b, "# TYPE openra2_vote_ballots gauge\n");
+    if (level.vote.proposal) {
+        G_MetricsPrintf(b, "openra2_vote_ballots{arena=\"0\",vote=\"yes\"} %d\n",
+                        level.vote.tally.votes[1] + level.vote.tally.admin[1]);
+        G_MetricsPrintf(b, "openra2_vote_ballots{arena=\"0\",vote=\"no\"} %d\n",
+                        level.vote.tally.votes[0] + level.vote.tally.admin[0]);
+    }
+    FOR_EACH_ARENA(a) {
+        if (!a->vote.proposal) {
+            continue;
+        }
+        G_MetricsPrintf(b, "openra2_vote_ballots{arena=\"%d\",vote=\"yes\"} %d\n",
+                        a->number, a->vote.tally.votes[1] + a->vote.tally.admin[1]);
+        G_MetricsPrintf(b, "openra2_vote_ballots{arena=\"%d\",vote=\"no\"} %d\n",
+                        a->number, a->vote.tally.votes[0] + a->vote.tally.admin[0]);
+    }
+
+    // per client gauges cover the last complete PERF_WINDOW
+    G_MetricsPrintf(b, "# HELP openra2_client_thinks_per_frame ClientThink calls per server frame, last 10 seconds.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_client_thinks_per_frame gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_thinks_per_frame", PERF_THINKS_PER_FRAME);
+    G_MetricsPrintf(b, "# TYPE openra2_client_pmove_avg_seconds gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_pmove_avg_seconds", PERF_PMOVE_AVG);
+    G_MetricsPrintf(b, "# TYPE openra2_client_pmove_max_seconds gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_pmove_max_seconds", PERF_PMOVE_MAX);
+    G_MetricsPrintf(b, "# HELP openra2_client_usercmds Usercmds by msec, last 10 seconds.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_client_usercmds gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_usercmds", PERF_USERCMDS);
+    G_MetricsPrintf(b, "# HELP openra2_client_reliable_bytes Reliable bytes unicast by the game, last 10 seconds.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_client_reliable_bytes gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_reliable_bytes", PERF_RELIABLE_BYTES);
+    G_MetricsPrintf(b, "# TYPE openra2_client_unreliable_bytes gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_unreliable_bytes", PERF_UNRELIABLE_BYTES);
+    G_MetricsPrintf(b, "# TYPE openra2_client_layouts gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_layouts", PERF_LAYOUTS);
+    G_MetricsPrintf(b, "# TYPE openra2_client_configstrings gauge\n");
+    G_ClientPerfMetrics(b, "openra2_client_configstrings", PERF_CONFIGSTRINGS);
+
+    G_MetricsPrintf(b, "# TYPE openra2_events_total counter\n");
+    G_MetricsPrintf(b, "openra2_events_total %u\n", events_stats.events);
+    G_MetricsPrintf(b, "# TYPE openra2_events_written_bytes_total counter\n");
+    G_MetricsPrintf(b, "openra2_events_written_bytes_total %"PRIu64"\n", events_stats.bytes);
+
+    G_MetricsPrintf(b, "# HELP openra2_sqlite_enabled Stats are logged to SQLite, synchronously at level change.\n");
+    G_MetricsPrintf(b, "# TYPE openra2_sqlite_enabled gauge\n");
+#if USE_SQLITE
+    G_MetricsPrintf(b, "openra2_sqlite_enabled 1\n");
+#else
+    G_MetricsPrintf(b, "openra2_sqlite_enabled 0\n");
+#endif
+}
+
+#ifndef _WIN32
+
+/**
+ *
+ */
+static void G_CloseMetricsConn(metrics_conn_t *c) {
+    close(c->fd);
+    G_BlobFree(&c->out);
+    c->active = qfalse;
+}
+
+/**
+ * Close the socket and every connection on it
+ */
+void G_CloseMetrics(void) {
+    int i;
+
+    for (i = 0; i < METRICS_CONNS; i++) {
+        if (metrics_conns[i].active) {
+            G_CloseMetricsConn(&metrics_conns[i]);
+        }
+    }
+    if (metrics_fd >= 0) {
+        close(metrics_fd);
+        unlink(metrics_path);
+        metrics_fd = -1;
+    }
+}
+
+/**
+ * Is path a socket nobody is listening on any more? Anything else there, a
+ * regular file or another server's live socket, must be left alone.
+ */
+static qboolean G_StaleMetricsSocket(const struct sockaddr_un *addr) {
+    struct stat st;
+    int fd, ret;
+
+    if (lstat(addr->sun_path, &st) || !S_ISSOCK(st.st_mode)) {
+        return qfalse;
+    }
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return qfalse;
+    }
+    ret = connect(fd, (const struct sockaddr *)addr, sizeof(*addr));
+    ret = ret < 0 && errno == ECONNREFUSED;
+    close(fd);
+    return ret;
+}
+
+/**
+ *
+ */
+static qboolean G_OpenMetrics(const char *path) {
+    struct stat st;
+    struct sockaddr_un addr;
+    int fd;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (Q_strlcpy(addr.sun_path, path, sizeof(addr.sun_path)) >= sizeof(addr.sun_path)) {
+        gi.dprintf("Metrics socket path too long: %s\n", path);
+        return qfalse;
+    }
+
+    // left behind by a server that didn't exit cleanly
+    if (!lstat(path, &st)) {
+        if (!G_StaleMetricsSocket(&addr)) {
+            gi.dprintf("Metrics socket %s is in use or not a socket, not serving metrics\n", path);
+            return qfalse;
+        }
+        unlink(path);
+    }
+
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        gi.dprintf("Couldn't create metrics socket: %s\n", strerror(errno));
+        return qfalse;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) || listen(fd, METRICS_CONNS)) {
+        gi.dprintf("Couldn't listen on metrics socket %s: %s\n", path, strerror(errno));
+        close(fd);
+        return qfalse;
+    }
+
+    Q_strlcpy(metrics_path, path, sizeof(metrics_path));
+    metrics_fd = fd;
+    gi.dprintf("Serving metrics on %s\n", path);
+    return qtrue;
+}
+
+/**
+ * Accept new scrapers and push out pending dumps. Called once per frame.
+ */
+void G_RunMetrics(void) {
+    metrics_conn_t *c;
+    uint64_t now;
+    ssize_t ret;
+    int i, fd;
+
+    if (g_metrics_socket->modified) {
+        g_metrics_socket->modified = qfalse;
+        G_CloseMetrics();
+        if (g_metrics_socket->string[0]) {
+            G_OpenMetrics(g_metrics_socket->string);
+        }
+    }
+
+    if (metrics_fd < 0) {
+        return;
+    }
+
+    now = G_Microseconds();
+
+    for (i = 0; i < METRICS_CONNS; i++) {
+        c = &metrics_conns[i];
+        if (c->active) {
+            continue;
+        }
+        fd = accept(metrics_fd, NULL, NULL);
+        if (fd < 0) {
+            break;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        c->active = qtrue;
+        c->fd = fd;
+        c->sent = 0;
+        c->opened = now;
+        memset(&c->out, 0, sizeof(c->out));
+        G_BuildMetrics(&c->out);
+        metrics.scrapes++;
+    }
+
+    for (i = 0; i < METRICS_CONNS; i++) {
+        c = &metrics_conns[i];
+        if (!c->active) {
+            continue;
+        }
+        ret = send(c->fd, c->out.data + c->sent, c->out.len - c->sent, MSG_NOSIGNAL);
+        if (ret > 0) {
+            c->sent += ret;
+        } else if (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            G_CloseMetricsConn(c);
+            continue;
+        }
+        if (c->sent == c->out.len || now - c->opened > METRICS_TIMEOUT) {
+            G_CloseMetricsConn(c);
+        }
+    }
+}
+
+#else
+
+void G_CloseMetrics(void) {}
+
+// no unix sockets here, 'sv metrics' still works
+void G_RunMetrics(void) {}
+
+#endif
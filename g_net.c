@@ -12,7 +12,7 @@ qboolean net_addressesMatch(netadr_t *a1, netadr_t *a2) {
         return false;
     }
     len = (a1->type == NA_IP6) ? IP6_LEN : IP4_LEN;
-    return memcmp(a1->ip.u8, a2->ip.u8, len);
+    return !memcmp(a1->ip.u8, a2->ip.u8, len);
 }
 
 /**
@@ -23,30 +23,38 @@ qboolean net_addressesMatch(netadr_t *a1, netadr_t *a2) {
  * incmask arg controls whether "/xx" cidr mask will be appended.
  */
 char *net_addressToString(netadr_t *address, qboolean wrapv6, qboolean incport, qboolean incmask) {
+    return net_addressToString_r(address, wrapv6, incport, incmask,
+            Q_ScratchBuffer(), MAX_STRING_CHARS);
+}
+
+/**
+ * Same as net_addressToString() but written into a caller supplied buffer
+ */
+char *net_addressToString_r(netadr_t *address, qboolean wrapv6, qboolean incport,
+        qboolean incmask, char *dest, size_t size) {
     char temp[INET6_ADDRSTRLEN];
-    static char dest[INET6_ADDRSTRLEN];
+    size_t len;
 
     memset(temp, 0, sizeof(temp));
-    memset(dest, 0, sizeof(dest));
 
     if (address->type == NA_IP6) {
         inet_ntop(AF_INET6, &address->ip.u8, temp, INET6_ADDRSTRLEN);
         if (wrapv6) {
-            strcpy(dest, va("[%s]", temp));
+            len = Q_scnprintf(dest, size, "[%s]", temp);
         } else {
-            strcpy(dest, temp);
+            len = Q_scnprintf(dest, size, "%s", temp);
         }
     } else {
         inet_ntop(AF_INET, &address->ip.u8, temp, INET_ADDRSTRLEN);
-        strcpy(dest, temp);
+        len = Q_scnprintf(dest, size, "%s", temp);
     }
 
     if (incmask) {
-        strcat(dest, va("/%d", address->mask_bits));
+        len += Q_scnprintf(dest + len, size - len, "/%d", address->mask_bits);
     }
 
     if (incport) {
-        strcat(dest, va(":%d", address->port));
+        Q_scnprintf(dest + len, size - len, ":%d", address->port);
     }
     return dest;
 }
@@ -35,6 +35,8 @@ typedef struct netadr_s {
 
 qboolean net_addressesMatch(netadr_t *a1, netadr_t *a2);
 char *net_addressToString(netadr_t *address, qboolean wrapv6, qboolean incport, qboolean incmask);
+char *net_addressToString_r(netadr_t *address, qboolean wrapv6, qboolean incport,
+        qboolean incmask, char *dest, size_t size);
 int net_ceil(float x);
 netadr_t net_cidrToMask(int cidr, netadrtype_t t);
 qboolean net_contains(netadr_t *network, netadr_t *host);
@@ -205,14 +205,49 @@ typedef struct {
 static pushed_t pushed[MAX_EDICTS], *pushed_p;
 static edict_t  *obstacle;
 
+// candidate riders/blockers for the current SV_Push
+static edict_t  *push_touch[MAX_EDICTS];
+
+/**
+ * qsort callback, keep candidates in edict order so blocking is resolved
+ * exactly like a linear scan over g_edicts would
+ */
+static int SV_PushCmp(const void *p1, const void *p2) {
+    const edict_t *a = *(const edict_t **)p1;
+    const edict_t *b = *(const edict_t **)p2;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * Collect every linked entity whose bounds touch the pusher's swept move.
+ * Anything standing on the pusher touches its starting bounds (absmin is
+ * already expanded by the server when linking), so riders are found too.
+ */
+static int SV_PushCandidates(edict_t *pusher, vec3_t oldmins, vec3_t oldmaxs) {
+    vec3_t  mins, maxs;
+    int     i, num;
+
+    for (i = 0; i < 3; i++) {
+        mins[i] = min(oldmins[i], pusher->absmin[i]) - 1;
+        maxs[i] = max(oldmaxs[i], pusher->absmax[i]) + 1;
+    }
+
+    num = gi.BoxEdicts(mins, maxs, push_touch, MAX_EDICTS, AREA_SOLID);
+    num += gi.BoxEdicts(mins, maxs, push_touch + num, MAX_EDICTS - num, AREA_TRIGGERS);
+
+    qsort(push_touch, num, sizeof(push_touch[0]), SV_PushCmp);
+    return num;
+}
+
 /**
  * Objects need to be moved back on a failed push, otherwise riders would
  * continue to slide.
  */
 static qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove) {
-    int         i, e;
+    int         i, e, num;
     edict_t     *check, *block;
-    vec3_t      mins, maxs;
+    vec3_t      mins, maxs, oldmins, oldmaxs;
     pushed_t    *p;
     vec3_t      org, org2, move2, forward, right, up;
 
@@ -245,13 +280,18 @@ static qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove) {
     pushed_p++;
 
 // move the pusher to it's final position
+    VectorCopy(pusher->absmin, oldmins);
+    VectorCopy(pusher->absmax, oldmaxs);
     VectorAdd(pusher->s.origin, move, pusher->s.origin);
     VectorAdd(pusher->s.angles, amove, pusher->s.angles);
     gi.linkentity(pusher);
 
+// only entities touching the swept bounds can ride or block
+    num = SV_PushCandidates(pusher, oldmins, oldmaxs);
+
 // see if any solid entities are inside the final position
-    check = g_edicts + 1;
-    for (e = 1; e < globals.num_edicts; e++, check++) {
+    for (e = 0; e < num; e++) {
+        check = push_touch[e];
         if (!check->inuse) {
             continue;
         }
@@ -365,6 +405,14 @@ static qboolean SV_Push(edict_t *pusher, vec3_t move, vec3_t amove) {
     return qtrue;
 }
 
+/**
+ * Is this part of a pusher team moving or rotating this frame?
+ */
+static qboolean SV_PartMoving(edict_t *part) {
+    return part->velocity[0] || part->velocity[1] || part->velocity[2] ||
+           part->avelocity[0] || part->avelocity[1] || part->avelocity[2];
+}
+
 /**
  * Bmodel objects don't interact with each other, but push all box objects
  */
@@ -383,9 +431,8 @@ static void SV_Physics_Pusher(edict_t *ent) {
 //retry:
     pushed_p = pushed;
     for (part = ent; part; part = part->teamchain) {
-        if (part->velocity[0] || part->velocity[1] || part->velocity[2] ||
-            part->avelocity[0] || part->avelocity[1] || part->avelocity[2]) {
-            // object is moving
+        // idle parts have nothing to push, an idle team just thinks
+        if (SV_PartMoving(part)) {
             VectorScale(part->velocity, FRAMETIME, move);
             VectorScale(part->avelocity, FRAMETIME, amove);
 
@@ -535,9 +582,9 @@ static void SV_Physics_Toss(edict_t *ent) {
     }
 
     if (!wasinwater && isinwater) {
-        gi.positioned_sound(old_origin, g_edicts, CHAN_AUTO, gi.soundindex("misc/h2ohit1.wav"), 1, 1, 0);
+        gi.positioned_sound(old_origin, g_edicts, CHAN_AUTO, level.sounds.splash, 1, 1, 0);
     } else if (wasinwater && !isinwater) {
-        gi.positioned_sound(ent->s.origin, g_edicts, CHAN_AUTO, gi.soundindex("misc/h2ohit1.wav"), 1, 1, 0);
+        gi.positioned_sound(ent->s.origin, g_edicts, CHAN_AUTO, level.sounds.splash, 1, 1, 0);
     }
 
     // move teamslaves
@@ -0,0 +1,577 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_save.c -- arena and match state snapshot kept across restarts
+
+#include "g_local.h"
+
+/**
+ * Snapshot file layout, all fields in host byte order:
+ *
+ *   snap_header_t
+ *   numarenas x snap_arena_t
+ *   numclients x snap_client_t
+ *
+ * Written when the game module shuts down and read back by the first
+ * G_SpawnEntities() of the next one, if it is for the same map and recent
+ * enough. Nothing here is a pointer, teams and arenas are stored as indexes
+ * and numbers and clients are matched by name and address when they come
+ * back.
+ *
+ * Matches resume at a round boundary: the arena keeps its settings, round
+ * number and team totals, players get their stats and team back, and the
+ * round that was running is replayed once everyone is ready again.
+ */
+#define SNAP_MAGIC      MakeRawLong('R', 'A', '2', 'S')
+#define SNAP_VERSION    1
+#define SNAP_FILE       "/cache/snapshot.bin"
+
+typedef struct {
+    uint32_t    magic;
+    uint32_t    version;
+    uint32_t    layout;     // struct sizes the records depend on
+    uint32_t    numarenas;
+    uint32_t    numclients;
+    uint32_t    checksum;   // FNV-1a of everything after the header
+    int64_t     time;       // when it was written
+    char        mapname[MAX_QPATH];
+} snap_header_t;
+
+typedef struct {
+    char        name[MAX_TEAM_NAME];
+    int32_t     locked;
+    uint32_t    damage_dealt;
+    uint32_t    damage_taken;
+    uint32_t    points;
+} snap_team_t;
+
+typedef struct {
+    uint32_t    number;
+    int32_t     state;
+    uint32_t    round_limit;
+    uint32_t    current_round;
+    uint32_t    weapon_flags;
+    uint32_t    damage_flags;
+    uint32_t    health;
+    uint32_t    armor;
+    uint32_t    timelimit;
+    int32_t     mode;
+    int32_t     scoremode;
+    int32_t     fastswitch;
+    int32_t     corpseview;
+    int32_t     modified;
+    uint32_t    team_count;
+    uint16_t    ammo[MAX_INVENTORY];
+    int32_t     infinite[MAX_INVENTORY];
+    snap_team_t teams[MAX_TEAMS];
+} snap_arena_t;
+
+typedef struct {
+    char        netname[MAX_NETNAME];
+    netadr_t    addr;
+    uint32_t    arena;      // arena number
+    int32_t     team;       // teams[] index, -1 for none
+    int32_t     captain;
+    int32_t     score;
+    int32_t     frags;
+    int32_t     damage;
+    client_respawn_t    resp;
+} snap_client_t;
+
+#define SNAP_LAYOUT     ((uint32_t)(sizeof(snap_arena_t) << 16 ^ sizeof(snap_client_t)))
+#define SNAP_MAX_SIZE   0x1000000
+
+// what was read and is still waiting to be applied
+typedef struct {
+    snap_arena_t    arena;
+    qboolean        pending;    // settings not applied yet
+    qboolean        resume;     // match was running, see G_ResumeArena()
+} snap_arena_state_t;
+
+typedef struct {
+    snap_client_t   client;
+    qboolean        pending;
+} snap_client_state_t;
+
+static snap_arena_state_t   *snap_arenas;
+static snap_client_state_t  *snap_clients;
+static uint32_t             snap_numarenas;
+static uint32_t             snap_numclients;
+static qboolean             snap_loadgame;  // read by G_ReadGame() for the next spawn
+static qboolean             snap_cleared;   // 'sv snapshot clear', skip the shutdown snapshot
+
+/**
+ *
+ */
+static size_t G_SnapshotPath(char *path, size_t size) {
+    if (!game.dir[0]) {
+        return 0;
+    }
+    return Q_concat(path, size, game.dir, SNAP_FILE, NULL);
+}
+
+/**
+ *
+ */
+static void G_SnapArena(snap_arena_t *s, arena_t *a) {
+    int i;
+
+    memset(s, 0, sizeof(*s));
+    s->number = a->number;
+    s->state = a->state;
+    s->round_limit = a->round_limit;
+    s->current_round = a->current_round;
+    s->weapon_flags = a->weapon_flags;
+    s->damage_flags = a->damage_flags;
+    s->health = a->health;
+    s->armor = a->armor;
+    s->timelimit = a->timelimit;
+    s->mode = a->mode;
+    s->scoremode = a->scoremode;
+    s->fastswitch = a->fastswitch;
+    s->corpseview = a->corpseview;
+    s->modified = a->modified;
+    s->team_count = a->team_count;
+    for (i = 0; i < MAX_INVENTORY; i++) {
+        s->ammo[i] = a->ammo[i];
+        s->infinite[i] = a->infinite[i];
+    }
+    for (i = 0; i < a->team_count && i < MAX_TEAMS; i++) {
+        Q_strlcpy(s->teams[i].name, a->teams[i].name, sizeof(s->teams[i].name));
+        s->teams[i].locked = a->teams[i].locked;
+        s->teams[i].damage_dealt = a->teams[i].damage_dealt;
+        s->teams[i].damage_taken = a->teams[i].damage_taken;
+        s->teams[i].points = a->teams[i].points;
+    }
+}
+
+/**
+ *
+ */
+static void G_SnapClient(snap_client_t *s, gclient_t *cl) {
+    arena_t *a = cl->pers.arena;
+    arena_team_t *t = cl->pers.team;
+
+    memset(s, 0, sizeof(*s));
+    Q_strlcpy(s->netname, cl->pers.netname, sizeof(s->netname));
+    s->addr = cl->pers.addr;
+    s->arena = a->number;
+    s->team = -1;
+    if (t && t >= a->teams && t < a->teams + a->team_count) {
+        s->team = t - a->teams;
+        s->captain = t->captain == cl->edict;
+    }
+    s->score = cl->pers.score;
+    s->frags = cl->pers.frags;
+    s->damage = cl->pers.damage;
+    s->resp = cl->resp;
+}
+
+/**
+ * Write the state of every arena and the players in them to filename, or
+ * the default snapshot path if NULL
+ */
+qboolean G_WriteSnapshot(const char *filename) {
+    char path[MAX_OSPATH], temp[MAX_OSPATH];
+    snap_header_t header;
+    cache_blob_t blob;
+    snap_arena_t sa;
+    snap_client_t sc;
+    gclient_t *cl;
+    arena_t *a;
+    FILE *fp;
+    size_t len;
+    int i;
+
+    if (!game.clients || !level.arena_count) {
+        return qfalse;
+    }
+
+    if (filename) {
+        len = Q_strlcpy(path, filename, sizeof(path));
+    } else {
+        len = G_SnapshotPath(path, sizeof(path));
+    }
+    if (!len || len >= sizeof(path)) {
+        return qfalse;
+    }
+    if (!filename) {
+        Q_concat(temp, sizeof(temp), game.dir, "/cache", NULL);
+        os_mkdir(temp);
+    }
+    len = Q_snprintf(temp, sizeof(temp), "%s.%d", path, (int)os_getpid());
+    if (len >= sizeof(temp)) {
+        return qfalse;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAP_MAGIC;
+    header.version = SNAP_VERSION;
+    header.layout = SNAP_LAYOUT;
+    header.time = time(NULL);
+    Q_strlcpy(header.mapname, level.mapname, sizeof(header.mapname));
+
+    memset(&blob, 0, sizeof(blob));
+    FOR_EACH_ARENA(a) {
+        G_SnapArena(&sa, a);
+        G_BlobAppend(&blob, &sa, sizeof(sa));
+        header.numarenas++;
+    }
+    for (i = 0; i < game.maxclients; i++) {
+        cl = &game.clients[i];
+        if (cl->pers.connected < CONN_PREGAME || !cl->pers.arena || cl->pers.mvdspec) {
+            continue;
+        }
+        G_SnapClient(&sc, cl);
+        G_BlobAppend(&blob, &sc, sizeof(sc));
+        header.numclients++;
+    }
+    header.checksum = G_CacheChecksum(blob.data, blob.len);
+
+    fp = fopen(temp, "wb");
+    if (!fp) {
+        G_BlobFree(&blob);
+        return qfalse;
+    }
+    if (fwrite(&header, sizeof(header), 1, fp) != 1 ||
+            fwrite(blob.data, 1, blob.len, fp) != blob.len) {
+        fclose(fp);
+        os_unlink(temp);
+        G_BlobFree(&blob);
+        return qfalse;
+    }
+    fclose(fp);
+    G_BlobFree(&blob);
+
+#ifdef _WIN32
+    os_unlink(path);
+#endif
+    if (rename(temp, path)) {
+        os_unlink(temp);
+        return qfalse;
+    }
+
+    gi.dprintf("Saved %u arenas and %u players to '%s'\n",
+               header.numarenas, header.numclients, path);
+    return qtrue;
+}
+
+/**
+ * Drop anything read but not yet applied
+ */
+void G_FreeSnapshot(void) {
+    if (snap_arenas) {
+        gi.TagFree(snap_arenas);
+    }
+    if (snap_clients) {
+        gi.TagFree(snap_clients);
+    }
+    snap_arenas = NULL;
+    snap_clients = NULL;
+    snap_numarenas = 0;
+    snap_numclients = 0;
+    snap_loadgame = qfalse;
+}
+
+/**
+ * Throw away the default snapshot, both the file and whatever was read from
+ * it, and don't write a new one when this game shuts down. For admins who
+ * restart a map to get rid of a broken match.
+ */
+void G_ClearSnapshot(void) {
+    char path[MAX_OSPATH];
+    size_t len;
+
+    G_FreeSnapshot();
+    snap_cleared = qtrue;
+
+    len = G_SnapshotPath(path, sizeof(path));
+    if (len && len < sizeof(path)) {
+        os_unlink(path);
+    }
+    gi.dprintf("Snapshot cleared, matches won't be kept over the next restart\n");
+}
+
+/**
+ * Keep running matches over a restart, unless that was turned off or an
+ * admin cleared the snapshot
+ */
+void G_ShutdownSnapshot(void) {
+    if (!snap_cleared && g_snapshot_age && g_snapshot_age->value > 0) {
+        G_WriteSnapshot(NULL);
+    }
+    G_FreeSnapshot();
+}
+
+/**
+ * Read a snapshot for mapname from filename, or the default snapshot path if
+ * NULL. The default one is removed once read so it only applies once.
+ */
+qboolean G_ReadSnapshot(const char *filename, const char *mapname) {
+    char path[MAX_OSPATH];
+    snap_header_t header;
+    byte *buffer, *p;
+    size_t len, size;
+    int64_t age;
+    FILE *fp;
+    uint32_t i;
+
+    G_FreeSnapshot();
+
+    if (filename) {
+        len = Q_strlcpy(path, filename, sizeof(path));
+    } else {
+        len = G_SnapshotPath(path, sizeof(path));
+    }
+    if (!len || len >= sizeof(path)) {
+        return qfalse;
+    }
+
+    fp = fopen(path, "rb");
+    if (!fp) {
+        return qfalse;
+    }
+    if (!filename) {
+        os_unlink(path);
+    }
+
+    buffer = NULL;
+    if (fread(&header, sizeof(header), 1, fp) != 1) {
+        goto fail;
+    }
+    if (header.magic != SNAP_MAGIC || header.version != SNAP_VERSION ||
+            header.layout != SNAP_LAYOUT || header.numarenas > MAX_ARENAS ||
+            header.numclients > MAX_CLIENTS) {
+        goto fail;
+    }
+
+    header.mapname[sizeof(header.mapname) - 1] = 0;
+    if (mapname && Q_stricmp(header.mapname, mapname)) {
+        gi.dprintf("Ignoring snapshot of %s on %s\n", header.mapname, mapname);
+        fclose(fp);
+        return qfalse;
+    }
+
+    age = (int64_t)time(NULL) - header.time;
+    if (!filename && (age < 0 || age > (int64_t)g_snapshot_age->value)) {
+        gi.dprintf("Ignoring snapshot from %d seconds ago\n", (int)age);
+        fclose(fp);
+        return qfalse;
+    }
+
+    size = header.numarenas * sizeof(snap_arena_t) +
+           header.numclients * sizeof(snap_client_t);
+    buffer = G_Malloc(size + 1);
+    if (fread(buffer, 1, size, fp) != size) {
+        goto fail;
+    }
+    if (G_CacheChecksum(buffer, size) != header.checksum) {
+        goto fail;
+    }
+    fclose(fp);
+
+    p = buffer;
+    snap_numarenas = header.numarenas;
+    snap_arenas = G_Malloc(sizeof(*snap_arenas) * (snap_numarenas + 1));
+    for (i = 0; i < snap_numarenas; i++, p += sizeof(snap_arena_t)) {
+        memcpy(&snap_arenas[i].arena, p, sizeof(snap_arena_t));
+        snap_arenas[i].pending = qtrue;
+        snap_arenas[i].resume = snap_arenas[i].arena.state > ARENA_STATE_WARMUP &&
+                                snap_arenas[i].arena.state < ARENA_STATE_MINTERMISSION;
+    }
+    snap_numclients = header.numclients;
+    snap_clients = G_Malloc(sizeof(*snap_clients) * (snap_numclients + 1));
+    for (i = 0; i < snap_numclients; i++, p += sizeof(snap_client_t)) {
+        memcpy(&snap_clients[i].client, p, sizeof(snap_client_t));
+        snap_clients[i].client.netname[MAX_NETNAME - 1] = 0;
+        snap_clients[i].pending = qtrue;
+    }
+    gi.TagFree(buffer);
+
+    snap_loadgame = filename != NULL;
+    gi.dprintf("Loaded %u arenas and %u players from '%s'\n",
+               snap_numarenas, snap_numclients, path);
+    return qtrue;
+
+fail:
+    gi.dprintf("Ignoring invalid snapshot '%s'\n", path);
+    fclose(fp);
+    if (buffer) {
+        gi.TagFree(buffer);
+    }
+    return qfalse;
+}
+
+/**
+ * Called by G_SpawnEntities(). Anything left from the previous level is
+ * dropped, the snapshot only applies to the first level after a restart.
+ */
+void G_SpawnSnapshot(const char *mapname) {
+    if (snap_loadgame) {
+        snap_loadgame = qfalse;
+        return;
+    }
+    G_FreeSnapshot();
+    if (g_snapshot_age->value > 0) {
+        G_ReadSnapshot(NULL, mapname);
+    }
+}
+
+/**
+ *
+ */
+static snap_arena_state_t *G_SnapshotArena(arena_t *a) {
+    uint32_t i;
+
+    for (i = 0; i < snap_numarenas; i++) {
+        if (snap_arenas[i].arena.number == a->number) {
+            return &snap_arenas[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Put back the settings an arena had, the first time one of its players
+ * returns. Doing it any earlier would be undone by G_ChangeArena() resetting
+ * a modified arena when its first client joins.
+ */
+static void G_RestoreArena(arena_t *a, snap_arena_state_t *sa) {
+    snap_arena_t *s = &sa->arena;
+    int i;
+
+    sa->pending = qfalse;
+
+    a->round_limit = s->round_limit;
+    a->weapon_flags = s->weapon_flags;
+    a->damage_flags = s->damage_flags;
+    a->health = s->health;
+    a->armor = s->armor;
+    a->timelimit = s->timelimit;
+    a->mode = s->mode;
+    a->scoremode = s->scoremode;
+    a->fastswitch = s->fastswitch;
+    a->corpseview = s->corpseview;
+    a->modified = s->modified;
+    for (i = 0; i < MAX_INVENTORY; i++) {
+        a->ammo[i] = s->ammo[i];
+        a->infinite[i] = s->infinite[i];
+    }
+    G_BuildLoadout(a);
+
+    if (s->team_count != a->team_count) {
+        sa->resume = qfalse;
+        return;
+    }
+    for (i = 0; i < a->team_count; i++) {
+        Q_strlcpy(a->teams[i].name, s->teams[i].name, sizeof(a->teams[i].name));
+        a->teams[i].locked = s->teams[i].locked;
+        a->teams[i].points = s->teams[i].points;
+    }
+    G_ArenaQueueWork(a, ARENA_WORK_STATUS);
+}
+
+/**
+ * A client just entered the game, give back what they had before the
+ * restart if the snapshot has them
+ */
+void G_RestoreClient(edict_t *ent) {
+    snap_client_state_t *sc;
+    snap_arena_state_t *sa;
+    snap_client_t *s;
+    gclient_t *cl = ent->client;
+    arena_t *a, *found;
+    uint32_t i;
+
+    for (i = 0; i < snap_numclients; i++) {
+        sc = &snap_clients[i];
+        if (sc->pending && !strcmp(sc->client.netname, cl->pers.netname) &&
+                net_addressesMatch(&sc->client.addr, &cl->pers.addr)) {
+            break;
+        }
+    }
+    if (i == snap_numclients) {
+        return;
+    }
+    sc->pending = qfalse;
+    s = &sc->client;
+
+    found = NULL;
+    FOR_EACH_ARENA(a) {
+        if (a->number == s->arena) {
+            found = a;
+            break;
+        }
+    }
+    if (!found) {
+        return;
+    }
+    a = found;
+
+    if (ARENA(ent) != a) {
+        G_ChangeArena(ent, a);
+    }
+
+    sa = G_SnapshotArena(a);
+    if (sa && sa->pending) {
+        G_RestoreArena(a, sa);
+    }
+
+    cl->pers.score = s->score;
+    cl->pers.frags = s->frags;
+    cl->pers.damage = s->damage;
+    cl->resp = s->resp;
+    cl->resp.enter_framenum = level.framenum;
+    cl->resp.activity_framenum = level.framenum;
+
+    if (s->team >= 0 && s->team < a->team_count) {
+        G_TeamJoin(ent, a->teams[s->team].type, qtrue);
+        if (s->captain && TEAM(ent) == &a->teams[s->team]) {
+            TEAM(ent)->captain = ent;
+        }
+    }
+    gi.cprintf(ent, PRINT_HIGH, "Restored your stats from before the restart\n");
+}
+
+/**
+ * A restored arena is starting its first round, continue the match that
+ * was interrupted instead of a new one
+ */
+void G_ResumeArena(arena_t *a) {
+    snap_arena_state_t *sa;
+    int i;
+
+    sa = G_SnapshotArena(a);
+    if (!sa || !sa->resume) {
+        return;
+    }
+    sa->resume = qfalse;
+
+    if (sa->arena.current_round < 1 || sa->arena.current_round > a->round_limit) {
+        return;
+    }
+    a->current_round = sa->arena.current_round;
+    for (i = 0; i < a->team_count; i++) {
+        a->teams[i].damage_dealt = sa->arena.teams[i].damage_dealt;
+        a->teams[i].damage_taken = sa->arena.teams[i].damage_taken;
+    }
+    G_ConfigString(a, CS_ROUND, G_RoundToString(a));
+    G_bprintf(a, PRINT_HIGH, "Resuming the interrupted match at round %d/%d\n",
+              a->current_round, a->round_limit);
+}
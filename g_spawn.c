@@ -266,6 +266,136 @@ static const field_t g_temps[] = {
     {NULL}
 };
 
+// name sorted views of the tables above, see G_InitSpawnTables()
+static const spawn_t    *spawn_index[q_countof(g_spawns)];
+static const gitem_t    *item_index[ITEM_TOTAL];
+static const field_t    *field_index[q_countof(g_fields)];
+static const field_t    *temp_index[q_countof(g_temps)];
+static size_t           spawn_count, item_count, field_count, temp_count;
+
+/**
+ * Sort by name, ties keep table order so the first entry still wins
+ */
+static int SpawnCmp(const void *a, const void *b) {
+    const spawn_t *s1 = *(const spawn_t **)a;
+    const spawn_t *s2 = *(const spawn_t **)b;
+    int r = strcmp(s1->name, s2->name);
+
+    return r ? r : (s1 > s2) - (s1 < s2);
+}
+
+static int ItemCmp(const void *a, const void *b) {
+    const gitem_t *i1 = *(const gitem_t **)a;
+    const gitem_t *i2 = *(const gitem_t **)b;
+    int r = strcmp(i1->classname, i2->classname);
+
+    return r ? r : (i1 > i2) - (i1 < i2);
+}
+
+static int FieldCmp(const void *a, const void *b) {
+    const field_t *f1 = *(const field_t **)a;
+    const field_t *f2 = *(const field_t **)b;
+    int r = Q_stricmp(f1->name, f2->name);
+
+    return r ? r : (f1 > f2) - (f1 < f2);
+}
+
+/**
+ * Build the sorted spawn, item and field indexes. The tables are constant so
+ * this only has to happen once per game.
+ */
+static void G_InitSpawnTables(void) {
+    const spawn_t *s;
+    const field_t *f;
+    int i;
+
+    if (spawn_count) {
+        return;
+    }
+
+    for (s = g_spawns; s->name; s++) {
+        spawn_index[spawn_count++] = s;
+    }
+    qsort(spawn_index, spawn_count, sizeof(spawn_index[0]), SpawnCmp);
+
+    for (i = 0; i < ITEM_TOTAL; i++) {
+        if (g_itemlist[i].classname) {
+            item_index[item_count++] = &g_itemlist[i];
+        }
+    }
+    qsort(item_index, item_count, sizeof(item_index[0]), ItemCmp);
+
+    for (f = g_fields; f->name; f++) {
+        field_index[field_count++] = f;
+    }
+    qsort(field_index, field_count, sizeof(field_index[0]), FieldCmp);
+
+    for (f = g_temps; f->name; f++) {
+        temp_index[temp_count++] = f;
+    }
+    qsort(temp_index, temp_count, sizeof(temp_index[0]), FieldCmp);
+}
+
+/**
+ * Binary search for the first spawn function named classname
+ */
+static const spawn_t *ED_FindSpawn(const char *classname) {
+    size_t lo = 0, hi = spawn_count, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (strcmp(spawn_index[mid]->name, classname) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < spawn_count && !strcmp(spawn_index[lo]->name, classname)) {
+        return spawn_index[lo];
+    }
+    return NULL;
+}
+
+/**
+ * Binary search for the first item with this classname
+ */
+static const gitem_t *ED_FindItem(const char *classname) {
+    size_t lo = 0, hi = item_count, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (strcmp(item_index[mid]->classname, classname) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < item_count && !strcmp(item_index[lo]->classname, classname)) {
+        return item_index[lo];
+    }
+    return NULL;
+}
+
+/**
+ * Binary search a sorted field index for key (case insensitive)
+ */
+static const field_t *ED_FindField(const field_t **index, size_t count, const char *key) {
+    size_t lo = 0, hi = count, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (Q_stricmp(index[mid]->name, key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < count && !Q_stricmp(index[lo]->name, key)) {
+        return index[lo];
+    }
+    return NULL;
+}
+
 /**
  * Parse strings such as:
  *   "-all +rg +cg:600 +gl"
@@ -477,7 +607,6 @@ qboolean G_ParseDamageString(arena_t *a, edict_t *ent, const char **input, uint3
 void ED_CallSpawn(edict_t *ent) {
     const spawn_t   *s;
     const gitem_t   *item;
-    int     i;
 
     if (!ent->classname) {
         gi.dprintf("%s: NULL classname\n", __func__);
@@ -485,35 +614,49 @@ void ED_CallSpawn(edict_t *ent) {
     }
 
     // check item spawn functions
-    for (i = 0, item = g_itemlist; i < ITEM_TOTAL; i++, item++) {
-        if (!item->classname) {
-            continue;
-        }
-        if (!strcmp(item->classname, ent->classname)) { // found it
-            SpawnItem(ent, (gitem_t *)item);
-            return;
-        }
+    item = ED_FindItem(ent->classname);
+    if (item) {
+        SpawnItem(ent, (gitem_t *)item);
+        return;
+    }
+
+    // decided once here instead of on every bfg think
+    if (G_ClassIs(ent, level.classnames.misc_explobox)) {
+        ent->flags |= FL_BFG_TARGET;
     }
 
     // check normal spawn functions
-    for (s = g_spawns; s->name; s++) {
-        if (!strcmp(s->name, ent->classname)) { // found it
-            s->spawn(ent);
-            return;
-        }
+    s = ED_FindSpawn(ent->classname);
+    if (s) {
+        s->spawn(ent);
+        return;
     }
     G_FreeEdict(ent);
 }
 
 /**
- *
+ * Intern the classnames the game checks for at runtime so those checks are
+ * usually a pointer compare, see G_ClassIs()
+ */
+static void G_InitClassnames(void) {
+    level.classnames.func_areaportal = G_InternString("func_areaportal");
+    level.classnames.func_door = G_InternString("func_door");
+    level.classnames.func_door_rotating = G_InternString("func_door_rotating");
+    level.classnames.func_train = G_InternString("func_train");
+    level.classnames.grenade = G_InternString("grenade");
+    level.classnames.weapon_bfg = G_InternString("weapon_bfg");
+    level.classnames.misc_explobox = G_InternString("misc_explobox");
+}
+
+/**
+ * Unescape an entity string and return its interned copy. Entities sharing
+ * a value (classnames, targets, models) share the same storage.
  */
 static char *ED_NewString(const char *string) {
-    char    *newb, *new_p;
+    char    newb[MAX_TOKEN_CHARS], *new_p;
     int     i, l;
 
-    l = strlen(string) + 1;
-    newb = gi.TagMalloc(l, TAG_LEVEL);
+    l = min(strlen(string) + 1, sizeof(newb));
     new_p = newb;
     for (i = 0; i < l; i++) {
         if (string[i] == '\\' && i < l - 1) {
@@ -527,54 +670,47 @@ static char *ED_NewString(const char *string) {
             *new_p++ = string[i];
         }
     }
-    return newb;
+    new_p[-1] = 0;     // already there unless the value got truncated
+    return G_InternString(newb);
 }
 
 /**
  * Takes a key/value pair and sets the binary values in an edict
  */
-static qboolean ED_ParseField(const field_t *fields, const char *key, const char *value, byte *b) {
-    const field_t   *f;
+static void ED_ParseField(const field_t *f, const char *key, const char *value, byte *b) {
     float   v;
     vec3_t  vec;
 
-    for (f = fields; f->name; f++) {
-        if (!Q_stricmp(f->name, key)) {
-            // found it
-            switch (f->type) {
-            case F_LSTRING:
-                *(char **)(b + f->ofs) = ED_NewString(value);
-                break;
-            case F_VECTOR:
-                if (sscanf(value, "%f %f %f", &vec[0], &vec[1], &vec[2]) != 3) {
-                    gi.dprintf("%s: couldn't parse '%s'\n", __func__, key);
-                    VectorClear(vec);
-                }
-                ((float *)(b + f->ofs))[0] = vec[0];
-                ((float *)(b + f->ofs))[1] = vec[1];
-                ((float *)(b + f->ofs))[2] = vec[2];
-                break;
-            case F_INT:
-                *(int *)(b + f->ofs) = atoi(value);
-                break;
-            case F_FLOAT:
-                *(float *)(b + f->ofs) = atof(value);
-                break;
-            case F_ANGLEHACK:
-                v = atof(value);
-                ((float *)(b + f->ofs))[0] = 0;
-                ((float *)(b + f->ofs))[1] = v;
-                ((float *)(b + f->ofs))[2] = 0;
-                break;
-            case F_IGNORE:
-                break;
-            default:
-                break;
-            }
-            return qtrue;
+    switch (f->type) {
+    case F_LSTRING:
+        *(char **)(b + f->ofs) = ED_NewString(value);
+        break;
+    case F_VECTOR:
+        if (sscanf(value, "%f %f %f", &vec[0], &vec[1], &vec[2]) != 3) {
+            gi.dprintf("%s: couldn't parse '%s'\n", __func__, key);
+            VectorClear(vec);
         }
+        ((float *)(b + f->ofs))[0] = vec[0];
+        ((float *)(b + f->ofs))[1] = vec[1];
+        ((float *)(b + f->ofs))[2] = vec[2];
+        break;
+    case F_INT:
+        *(int *)(b + f->ofs) = atoi(value);
+        break;
+    case F_FLOAT:
+        *(float *)(b + f->ofs) = atof(value);
+        break;
+    case F_ANGLEHACK:
+        v = atof(value);
+        ((float *)(b + f->ofs))[0] = 0;
+        ((float *)(b + f->ofs))[1] = v;
+        ((float *)(b + f->ofs))[2] = 0;
+        break;
+    case F_IGNORE:
+        break;
+    default:
+        break;
     }
-    return qfalse;
 }
 
 /**
@@ -583,6 +719,7 @@ static qboolean ED_ParseField(const field_t *fields, const char *key, const char
  * ed should be a properly initialized empty edict.
  */
 static void ED_ParseEdict(const char **data, edict_t *ent) {
+    const field_t   *f;
     qboolean    init;
     char        *key, *value;
 
@@ -618,10 +755,13 @@ static void ED_ParseEdict(const char **data, edict_t *ent) {
             continue;
         }
 
-        if (!ED_ParseField(g_fields, key, value, (byte *)ent)) {
-            if (!ED_ParseField(g_temps, key, value, (byte *)&st)) {
-                gi.dprintf("%s: %s is not a field\n", __func__, key);
-            }
+        level.load.fields++;
+        if ((f = ED_FindField(field_index, field_count, key)) != NULL) {
+            ED_ParseField(f, key, value, (byte *)ent);
+        } else if ((f = ED_FindField(temp_index, temp_count, key)) != NULL) {
+            ED_ParseField(f, key, value, (byte *)&st);
+        } else {
+            gi.dprintf("%s: %s is not a field\n", __func__, key);
         }
     }
 
@@ -687,6 +827,7 @@ static void G_ParseString(void) {
     edict_t     *ent;
     int         inhibit = 0;
     char        *token;
+    uint64_t    start;
 
     // parse ents
     while (1) {
@@ -700,7 +841,10 @@ static void G_ParseString(void) {
         }
 
         ent = G_Spawn();
+        start = G_Microseconds();
         ED_ParseEdict(&entities, ent);
+        level.load.parse_us += G_Microseconds() - start;
+        level.load.entities++;
 
         // remove things from different skill levels or deathmatch
         if (ent->spawnflags & SPAWNFLAG_NOT_DEATHMATCH) {
@@ -717,7 +861,9 @@ static void G_ParseString(void) {
             inhibit++;
         }
         ent->spawnflags &= ~INHIBIT_MASK;
+        start = G_Microseconds();
         ED_CallSpawn(ent);
+        level.load.spawn_us += G_Microseconds() - start;
     }
     gi.cprintf(NULL, PRINT_HIGH, "%i entities inhibited\n", inhibit);
 }
@@ -789,6 +935,18 @@ void sort_arenas() {
     }
 }
 
+/**
+ * Report how long the last entity string took to load. Goes to the console
+ * when ent is NULL, otherwise to that client.
+ */
+void G_LoadStats(edict_t *ent) {
+    gi.cprintf(ent, PRINT_HIGH,
+            "%s: %d entities, %d fields, parse %.2fms, spawn %.2fms, total %.2fms\n",
+            level.mapname, level.load.entities, level.load.fields,
+            level.load.parse_us / 1000.0, level.load.spawn_us / 1000.0,
+            level.load.total_us / 1000.0);
+}
+
 /**
  * Creates a server's entity / program execution context by parsing textual
  * entity definitions out of an ent file.
@@ -802,16 +960,19 @@ void G_SpawnEntities(const char *mapname, const char *entities, const char *spaw
     char        playerskin[MAX_QPATH];
     qboolean    notra2map = qfalse;
     size_t      parsed_arenas;
+    uint64_t    start = G_Microseconds(), now;
 
 #if USE_SQLITE
     G_OpenDatabase();
     G_LogClients();
 #endif
 
-    gi.FreeTags(TAG_LEVEL);
+    G_FreeLevelMemory();
 
     memset(&level, 0, sizeof(level));
     memset(g_edicts, 0, game.maxentities * sizeof(g_edicts[0]));
+    G_InitClassnames();
+    G_InitSpawnTables();
 
     Q_strlcpy(level.mapname, mapname, sizeof(level.mapname));
 
@@ -853,8 +1014,11 @@ void G_SpawnEntities(const char *mapname, const char *entities, const char *spaw
     }
 
     ent = g_edicts;
+    now = G_Microseconds();
     ED_ParseEdict(&entities, ent);
+    level.load.parse_us += G_Microseconds() - now;
     ED_CallSpawn(ent);
+    level.load.entities++;
 
     level.entstring = entities;
 
@@ -863,6 +1027,7 @@ void G_SpawnEntities(const char *mapname, const char *entities, const char *spaw
 
     memset(&level.arena_defaults, 0, sizeof(arena_entry_t) * MAX_ARENAS);
     parsed_arenas = G_ParseMapSettings(level.arena_defaults, mapname);
+    G_SaveConfigCache();
 
     // find arenas
     List_Init(&g_arenalist);
@@ -935,6 +1100,9 @@ void G_SpawnEntities(const char *mapname, const char *entities, const char *spaw
     }
 
     G_BuildMenu();
+    G_RebuildVoteTally();
+    G_SpawnSnapshot(mapname);
+    G_OpenEventLog(mapname);
 
     level.map = G_FindMap(mapname);
 
@@ -969,6 +1137,9 @@ void G_SpawnEntities(const char *mapname, const char *entities, const char *spaw
     if ((int)timelimit->value > 0) {
         ClockStartMapTimelimit((int)timelimit->value * 60);
     }
+
+    level.load.total_us = G_Microseconds() - start;
+    G_LoadStats(NULL);
 }
 
 /**
@@ -978,8 +1149,11 @@ void G_ResetLevel(void) {
     gclient_t *client;
     edict_t *ent;
     int i;
+    uint64_t start;
 
-    gi.FreeTags(TAG_LEVEL);
+    G_FreeLevelMemory();
+    G_InitClassnames();
+    memset(&level.load, 0, sizeof(level.load));
 
 #if USE_SQLITE
     G_LogClients();
@@ -1009,8 +1183,10 @@ void G_ResetLevel(void) {
     InitBodyQue();
 
     // respawn all edicts
+    start = G_Microseconds();
     G_ParseString();
     G_FindTeams();
+    level.load.total_us = G_Microseconds() - start;
 
     // respawn all clients
     for (i = 0; i < game.maxclients; i++) {
@@ -1168,6 +1344,7 @@ static const char statusbar[] =
  */
 void SP_worldspawn(edict_t *ent) {
     char buffer[MAX_QPATH];
+    int i;
 
     ent->movetype = MOVETYPE_PUSH;
     ent->solid = SOLID_BSP;
@@ -1212,6 +1389,12 @@ void SP_worldspawn(edict_t *ent) {
 
     PrecacheItem(INDEX_ITEM(ITEM_BLASTER));
 
+    // everything an arena loadout can hand out, see G_BuildLoadout()
+    for (i = ITEM_SHOTGUN; i <= ITEM_SLUGS; i++) {
+        PrecacheItem(INDEX_ITEM(i));
+    }
+    PrecacheItem(INDEX_ITEM(ITEM_ARMOR_BODY));
+
     gi.soundindex("player/lava1.wav");
     gi.soundindex("player/lava2.wav");
     gi.soundindex("misc/pc_up.wav");
@@ -1296,6 +1479,30 @@ void SP_worldspawn(edict_t *ent) {
     level.sounds.rg_hum = gi.soundindex("weapons/rg_hum.wav");
     level.sounds.bfg_hum = gi.soundindex("weapons/bfg_hum.wav");
 
+    // weapon and projectile sounds/models, used every shot
+    level.sounds.hgrenade_bounce[0] = gi.soundindex("weapons/hgrenb1a.wav");
+    level.sounds.hgrenade_bounce[1] = gi.soundindex("weapons/hgrenb2a.wav");
+    level.sounds.hgrenade_tick = gi.soundindex("weapons/hgrenc1b.wav");
+    level.sounds.hgrenade_throw = gi.soundindex("weapons/hgrena1b.wav");
+    level.sounds.hgrenade_timer = gi.soundindex("weapons/hgrent1a.wav");
+    level.sounds.grenade_bounce = gi.soundindex("weapons/grenlb1b.wav");
+    level.sounds.hyperblaster_loop = gi.soundindex("weapons/hyprbl1a.wav");
+    level.sounds.hyperblaster_down = gi.soundindex("weapons/hyprbd1a.wav");
+    level.sounds.chaingun_up = gi.soundindex("weapons/chngnu1a.wav");
+    level.sounds.chaingun_down = gi.soundindex("weapons/chngnd1a.wav");
+    level.sounds.chaingun_loop = gi.soundindex("weapons/chngnl1a.wav");
+    level.sounds.blaster_fly = gi.soundindex("misc/lasfly.wav");
+    level.sounds.rocket_fly = gi.soundindex("weapons/rockfly.wav");
+    level.sounds.bfg_explode = gi.soundindex("weapons/bfg__x1b.wav");
+    level.sounds.bfg_fly = gi.soundindex("weapons/bfg__l1a.wav");
+
+    level.models.laser = gi.modelindex("models/objects/laser/tris.md2");
+    level.models.grenade = gi.modelindex("models/objects/grenade/tris.md2");
+    level.models.hgrenade = gi.modelindex("models/objects/grenade2/tris.md2");
+    level.models.rocket = gi.modelindex("models/objects/rocket/tris.md2");
+    level.models.bfg = gi.modelindex("sprites/s_bfg1.sp2");
+    level.models.bfg_explode = gi.modelindex("sprites/s_bfg3.sp2");
+
     // sexed models
     // THIS ORDER MUST MATCH THE DEFINES IN g_local.h
     // you can add more, max 15
@@ -1321,10 +1528,16 @@ void SP_worldspawn(edict_t *ent) {
 
     gi.soundindex("items/pkup.wav");        // bonus item pickup
     gi.soundindex("world/land.wav");        // landing thud
-    gi.soundindex("misc/h2ohit1.wav");      // landing splash
-    gi.soundindex("items/damage.wav");
-    gi.soundindex("items/protect.wav");
-    gi.soundindex("items/protect4.wav");
+    level.sounds.splash = gi.soundindex("misc/h2ohit1.wav");    // landing splash
+    level.sounds.damage[0] = gi.soundindex("items/damage.wav");
+    level.sounds.damage[1] = gi.soundindex("items/damage2.wav");
+    level.sounds.damage[2] = gi.soundindex("items/damage3.wav");
+    level.sounds.protect[0] = gi.soundindex("items/protect.wav");
+    level.sounds.protect[1] = gi.soundindex("items/protect2.wav");
+    level.sounds.protect[2] = gi.soundindex("items/protect4.wav");
+    level.sounds.power[0] = gi.soundindex("misc/power1.wav");
+    level.sounds.power[1] = gi.soundindex("misc/power2.wav");
+    level.sounds.airout = gi.soundindex("items/airout.wav");
     gi.soundindex("infantry/inflies1.wav");
 
     level.sounds.noammo = gi.soundindex("weapons/noammo.wav");
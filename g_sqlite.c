@@ -106,6 +106,7 @@ void G_EndLogging(void) {
  */
 void G_LogClient(gclient_t *c) {
     unsigned long clock;
+    playerstats_t stats;
     fragstat_t *fs;
     itemstat_t *is;
     int i, ret;
@@ -138,17 +139,20 @@ void G_LogClient(gclient_t *c) {
         //gi.dprintf( "created player_id=%llu\n", rowid );
     }
 
+    // finished rounds plus the one in progress
+    G_ClientStats(c, &stats);
+
     // MapChange \current\%s\next\%s\players\%d
     // PlayerBegin \name\%s\id\%s
     // PlayerEnd \name\%s\id\%s
     // PlayerStats \name\%s\id\%s\time\%d\frg\%d\dth\%d\dmg\%d\dmr\%d\w%d\%d,%d,%d,%d,%d\i%d\%d,%d,%d
     db_execute("INSERT INTO records VALUES(%llu,%lu,%d,%d,%d,%d,%d)", rowid,
             clock, (level.framenum - c->resp.enter_framenum) / HZ,
-            c->resp.score, c->resp.deaths, c->resp.damage_given,
-            c->resp.damage_recvd);
+            c->resp.score, c->resp.deaths, stats.damage_given,
+            stats.damage_recvd);
 
     for (i = 0; i < FRAG_TOTAL; i++) {
-        fs = &c->resp.frags[i];
+        fs = &stats.frags[i];
         if (fs->kills || fs->deaths || fs->suicides || fs->atts || fs->hits) {
             db_execute("INSERT INTO frags VALUES(%llu,%lu,%d,%d,%d,%d,%d,%d)",
                     rowid, clock, i, fs->kills, fs->deaths, fs->suicides,
@@ -157,7 +161,7 @@ void G_LogClient(gclient_t *c) {
     }
 
     for (i = 0; i < ITEM_TOTAL; i++) {
-        is = &c->resp.items[i];
+        is = &stats.items[i];
         if (is->pickups || is->misses || is->kills) {
             db_execute("INSERT INTO items VALUES(%llu,%lu,%d,%d,%d,%d)", rowid,
                     clock, i, is->pickups, is->misses, is->kills);
@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// g_stats.c -- per round weapon and item counters
+
+#include "g_local.h"
+
+/**
+ * Everything a player does in a round is counted in one row of
+ * level.round_stats, found by arena, team and the player's slot in that
+ * team. Accounting is a single add into that row.
+ *
+ * When the round ends the rows are added into each player's resp.stats
+ * and the team totals, then cleared. Rows are plain int arrays, so every
+ * sum here is one flat loop the compiler can vectorize.
+ */
+#define STATS_INTS  (sizeof(playerstats_t) / sizeof(int))
+
+/**
+ * to += from
+ */
+static void G_AddStats(playerstats_t *to, const playerstats_t *from) {
+    int *d = (int *)to;
+    const int *s = (const int *)from;
+    size_t i;
+
+    for (i = 0; i < STATS_INTS; i++) {
+        d[i] += s[i];
+    }
+}
+
+/**
+ * ent's row for this round, NULL if it isn't on a team
+ */
+playerstats_t *G_FindPlayerStats(edict_t *ent) {
+    arena_t *a = ent->client->pers.arena;
+    arena_team_t *team = ent->client->pers.team;
+    int i;
+
+    if (a && team) {
+        for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
+            if (team->players[i] == ent) {
+                return &level.round_stats[a->number][team - a->teams][i];
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * The row ent's counters for this round go to. Never NULL so accounting
+ * needs no checks, writes for players without a team land in a sink that
+ * is never read.
+ */
+playerstats_t *G_PlayerStats(edict_t *ent) {
+    static playerstats_t discard;
+    playerstats_t *row = G_FindPlayerStats(ent);
+
+    return row ? row : &discard;
+}
+
+/**
+ * Finished rounds plus the one being played
+ */
+void G_ClientStats(gclient_t *c, playerstats_t *out) {
+    playerstats_t *row = NULL;
+
+    *out = c->resp.stats;
+    if (c->edict && c->edict->client) {
+        row = G_FindPlayerStats(c->edict);
+    }
+    if (row) {
+        G_AddStats(out, row);
+    }
+}
+
+/**
+ * Team totals for the match so far, including the round being played
+ */
+void G_TeamStats(arena_t *a, arena_team_t *team, playerstats_t *out) {
+    int t = team - a->teams;
+    int i;
+
+    *out = level.team_stats[a->number][t];
+    for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
+        G_AddStats(out, &level.round_stats[a->number][t][i]);
+    }
+}
+
+/**
+ * Hits per attempt over the hitscan and projectile weapons, BFG excluded
+ * since its lasers don't count attempts. Percent, -1 without attempts.
+ */
+int G_StatsAccuracy(const playerstats_t *s) {
+    int i, hits = 0, atts = 0;
+
+    for (i = FRAG_BLASTER; i <= FRAG_RAILGUN; i++) {
+        hits += s->frags[i].hits;
+        atts += s->frags[i].atts;
+    }
+    return atts ? hits * 100 / atts : -1;
+}
+
+/**
+ * ent is leaving its team, keep what it did this round
+ */
+void G_FoldPlayerStats(edict_t *ent) {
+    arena_t *a = ent->client->pers.arena;
+    arena_team_t *team = ent->client->pers.team;
+    playerstats_t *row = G_FindPlayerStats(ent);
+
+    if (!row) {
+        return;
+    }
+    G_AddStats(&ent->client->resp.stats, row);
+    G_AddStats(&level.team_stats[a->number][team - a->teams], row);
+    memset(row, 0, sizeof(*row));
+}
+
+/**
+ * Round is over, move every row into its player's and team's totals.
+ * Empty slots have zero rows, so they are added too rather than skipped.
+ */
+void G_FoldRoundStats(arena_t *a) {
+    playerstats_t *rows, *total;
+    arena_team_t *team;
+    int t, i;
+
+    for (t = 0; t < a->team_count; t++) {
+        team = &a->teams[t];
+        rows = level.round_stats[a->number][t];
+        total = &level.team_stats[a->number][t];
+
+        for (i = 0; i < MAX_TEAM_PLAYERS; i++) {
+            G_AddStats(total, &rows[i]);
+            if (team->players[i]) {
+                G_AddStats(&team->players[i]->client->resp.stats, &rows[i]);
+            }
+        }
+        memset(rows, 0, sizeof(level.round_stats[0][0]));
+    }
+}
+
+/**
+ * New match, start the team totals over. Anything still in the rows was
+ * folded into the players' totals by the caller first.
+ */
+void G_ClearArenaStats(arena_t *a) {
+    memset(level.round_stats[a->number], 0, sizeof(level.round_stats[0]));
+    memset(level.team_stats[a->number], 0, sizeof(level.team_stats[0]));
+}
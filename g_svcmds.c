@@ -95,6 +95,152 @@ static void Svcmd_MapQueue_f(void) {
     }
 }
 
+/**
+ * Show how much trig the cached client view basis is saving
+ */
+static void Svcmd_ViewStats_f(void) {
+    uint32_t total = view_stats.hits + view_stats.misses;
+
+    Com_Printf("view basis requests: %u\n", total);
+    Com_Printf("  rebuilt: %u\n", view_stats.misses);
+    Com_Printf("  cached:  %u (%u sin/cos calls avoided)\n",
+               view_stats.hits, view_stats.hits * 6);
+
+    if (gi.argc() > 2 && !strcmp(gi.argv(2), "reset")) {
+        memset(&view_stats, 0, sizeof(view_stats));
+    }
+}
+
+/**
+ * Show how many player stat writes G_SetStats() has been able to skip
+ */
+static void Svcmd_HudStats_f(void) {
+    uint32_t total = hud_stats.writes + hud_stats.skipped;
+    uint32_t frames = max(hud_stats.frames, 1);
+
+    Com_Printf("stat frames: %u (%u client updates, %u full rebuilds)\n",
+               hud_stats.frames, hud_stats.calls, hud_stats.rebuilds);
+    Com_Printf("  written: %u (%u per frame)\n", hud_stats.writes, hud_stats.writes / frames);
+    Com_Printf("  skipped: %u (%u per frame, %u%%)\n", hud_stats.skipped,
+               hud_stats.skipped / frames, total ? (uint32_t) ((uint64_t) hud_stats.skipped * 100 / total) : 0);
+
+    if (gi.argc() > 2 && !strcmp(gi.argv(2), "reset")) {
+        memset(&hud_stats, 0, sizeof(hud_stats));
+    }
+}
+
+/**
+ * Show how much level memory came out of the bump allocator
+ */
+static void Svcmd_LevelMem_f(void) {
+    Com_Printf("level memory: %u allocations in %u chunks\n",
+               level_mem.allocs, level_mem.chunks);
+    Com_Printf("  used:     %"PRIz" bytes\n", level_mem.used);
+    Com_Printf("  reserved: %"PRIz" bytes\n", level_mem.reserved);
+    Com_Printf("interned strings: %u (%u duplicates shared)\n",
+               level_mem.interned, level_mem.intern_hits);
+}
+
+/**
+ * Show how much effect traffic each arena generated through G_ArenaMulticast()
+ */
+static void Svcmd_Multicast_f(void) {
+    arena_t *a;
+
+    Com_Printf("arena messages    sends       bytes\n"
+               "----- -------- -------- -----------\n");
+    FOR_EACH_ARENA(a) {
+        Com_Printf("%5d %8u %8u %11u\n", a->number, a->multicast.messages,
+                   a->multicast.sends, a->multicast.bytes);
+    }
+}
+
+/**
+ * Forget parsed mapcfg files and their snapshot records, the next map load
+ * reads them from disk again
+ */
+static void Svcmd_ReloadCfg_f(void) {
+    Com_Printf("mapcfg cache: %u files, %u hits, %u misses, %u reads\n",
+               mapcfg_stats.cached, mapcfg_stats.hits, mapcfg_stats.misses,
+               mapcfg_stats.reads);
+    Com_Printf("config snapshot: %u records, %u hits, %u misses, %u writes\n",
+               cache_stats.records, cache_stats.hits, cache_stats.misses,
+               cache_stats.writes);
+    G_FlushMapSettings();
+    G_InvalidateConfigCache();
+    Com_Printf("mapcfg cache and config snapshot flushed, changes apply on the next map load\n");
+}
+
+/**
+ * Show how often players actually had to test against projectiles
+ */
+static void Svcmd_ProjStats_f(void) {
+    int i;
+
+    Com_Printf("live projectiles: world %d", level.projectiles.live[0]);
+    for (i = 1; i < MAX_ARENAS; i++) {
+        if (level.projectiles.live[i]) {
+            Com_Printf(", arena %d: %d", i, level.projectiles.live[i]);
+        }
+    }
+    Com_Printf("\n");
+    Com_Printf("projectile checks: %u\n", level.projectiles.checks);
+    Com_Printf("  skipped: %u\n", level.projectiles.skipped);
+    Com_Printf("  box sweeps: %u, touches: %u\n", level.projectiles.tests,
+               level.projectiles.touches);
+}
+
+/**
+ * Per client counters for the last 10 seconds
+ */
+static void Svcmd_ClientPerf_f(void) {
+    gclient_t *cl;
+    int i;
+
+    if (gi.argc() < 3) {
+        for (i = 0, cl = game.clients; i < game.maxclients; i++, cl++) {
+            if (cl->pers.connected != CONN_DISCONNECTED) {
+                G_PrintClientPerf(cl);
+            }
+        }
+        return;
+    }
+
+    i = atoi(gi.argv(2));
+    if (i < 0 || i >= game.maxclients || !COM_IsUint(gi.argv(2))) {
+        Com_Printf("Usage: sv clientperf [id]\n");
+        return;
+    }
+    cl = &game.clients[i];
+    if (cl->pers.connected == CONN_DISCONNECTED) {
+        Com_Printf("Client %d is not connected\n", i);
+        return;
+    }
+    G_PrintClientPerf(cl);
+}
+
+/**
+ * Print the same dump the metrics socket serves
+ */
+static void Svcmd_Metrics_f(void) {
+    cache_blob_t b;
+    char *line, *end;
+
+    memset(&b, 0, sizeof(b));
+    G_BuildMetrics(&b);
+    G_BlobAppend(&b, "", 1);
+
+    // one line at a time, the whole dump is longer than a print buffer
+    for (line = (char *)b.data; *line; line = end + 1) {
+        end = strchr(line, '\n');
+        if (!end) {
+            break;
+        }
+        Com_Printf("%.*s\n", (int)(end - line), line);
+    }
+    G_BlobFree(&b);
+}
+
 /**
  * ServerCommand will be called when an "sv" command is issued. The game can
  * issue gi.argc() / gi.argv() commands to get the rest of the parameters
@@ -134,6 +280,30 @@ void G_ServerCommand(void) {
         Cmd_Stats_f(NULL, qtrue);
     } else if (!strcmp(cmd, "settings") || !strcmp(cmd, "matchinfo")) {
         Cmd_Settings_f(NULL);
+    } else if (!strcmp(cmd, "viewstats")) {
+        Svcmd_ViewStats_f();
+    } else if (!strcmp(cmd, "projstats")) {
+        Svcmd_ProjStats_f();
+    } else if (!strcmp(cmd, "hudstats")) {
+        Svcmd_HudStats_f();
+    } else if (!strcmp(cmd, "levelmem")) {
+        Svcmd_LevelMem_f();
+    } else if (!strcmp(cmd, "loadstats")) {
+        G_LoadStats(NULL);
+    } else if (!strcmp(cmd, "reloadcfg")) {
+        Svcmd_ReloadCfg_f();
+    } else if (!strcmp(cmd, "multicast")) {
+        Svcmd_Multicast_f();
+    } else if (!strcmp(cmd, "snapshot")) {
+        if (gi.argc() > 2 && !strcmp(gi.argv(2), "clear")) {
+            G_ClearSnapshot();
+        } else {
+            G_WriteSnapshot(NULL);
+        }
+    } else if (!strcmp(cmd, "metrics")) {
+        Svcmd_Metrics_f();
+    } else if (!strcmp(cmd, "clientperf")) {
+        Svcmd_ClientPerf_f();
     } else if (!strcmp(cmd, "test2")) {
         arena_t *ar;
         FOR_EACH_ARENA(ar) {
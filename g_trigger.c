@@ -325,7 +325,7 @@ void SP_trigger_always(edict_t *ent) {
  *
  */
 static void trigger_push_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf) {
-    if (strcmp(other->classname, "grenade") == 0) {
+    if (G_ClassIs(other, level.classnames.grenade)) {
         VectorScale(self->movedir, self->speed * 10, other->velocity);
     } else if (other->health > 0) {
         VectorScale(self->movedir, self->speed * 10, other->velocity);
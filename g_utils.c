@@ -21,6 +21,12 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 
 #include "g_local.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
 /**
  *
  */
@@ -54,7 +60,8 @@ edict_t *G_Find(edict_t *from, size_t fieldofs, char *match) {
         if (!s) {
             continue;
         }
-        if (!Q_stricmp(s, match)) {
+        // interned map strings often share the pointer
+        if (s == match || !Q_stricmp(s, match)) {
             return from;
         }
     }
@@ -92,6 +99,51 @@ edict_t *findradius(edict_t *from, vec3_t org, float rad) {
     return NULL;
 }
 
+/**
+ *
+ */
+static int EdictCmp(const void *a, const void *b) {
+    const edict_t *e1 = *(const edict_t **)a, *e2 = *(const edict_t **)b;
+
+    return (e1 > e2) - (e1 < e2);
+}
+
+/**
+ * Same test as findradius(), but only looks at the solid entities the
+ * server's area grid has near org instead of walking every edict.
+ * Triggers are not returned. Results are in edict order.
+ */
+int G_FindRadius(vec3_t org, float rad, edict_t **list, int maxcount) {
+    edict_t *touch[MAX_EDICTS];
+    edict_t *e;
+    vec3_t  mins, maxs, eorg;
+    int     i, j, num, count;
+
+    for (i = 0; i < 3; i++) {
+        mins[i] = org[i] - rad;
+        maxs[i] = org[i] + rad;
+    }
+
+    count = 0;
+    num = gi.BoxEdicts(mins, maxs, touch, MAX_EDICTS, AREA_SOLID);
+    for (i = 0; i < num && count < maxcount; i++) {
+        e = touch[i];
+        if (!e->inuse || e->solid == SOLID_NOT) {
+            continue;
+        }
+        for (j = 0; j < 3; j++) {
+            eorg[j] = org[j] - (e->s.origin[j] + (e->mins[j] + e->maxs[j]) * 0.5);
+        }
+        if (VectorLength(eorg) > rad) {
+            continue;
+        }
+        list[count++] = e;
+    }
+
+    qsort(list, count, sizeof(list[0]), EdictCmp);
+    return count;
+}
+
 #define MAXCHOICES  8
 
 /**
@@ -191,8 +243,8 @@ void G_UseTargets(edict_t *ent, edict_t *activator) {
         t = NULL;
         while ((t = G_Find(t, FOFS(targetname), ent->target))) {
             // doors fire area portals in a specific way
-            if (!Q_stricmp(t->classname, "func_areaportal") &&
-                (!Q_stricmp(ent->classname, "func_door") || !Q_stricmp(ent->classname, "func_door_rotating"))) {
+            if (G_ClassIs(t, level.classnames.func_areaportal) &&
+                (G_ClassIs(ent, level.classnames.func_door) || G_ClassIs(ent, level.classnames.func_door_rotating))) {
                 continue;
             }
 
@@ -232,19 +284,20 @@ float *tv(float x, float y, float z) {
     return v;
 }
 
+/**
+ * Format a vector into a caller supplied buffer
+ */
+char *vtos_r(vec3_t v, char *out, size_t size) {
+    Q_snprintf(out, size, "(%i %i %i)", (int)v[0], (int)v[1], (int)v[2]);
+    return out;
+}
+
 /**
  * This is just a convenience function for printing vectors
  */
 char *vtos(vec3_t v) {
-    static  int     index;
-    static  char    str[8][32];
-    char    *s;
-
-    // use an array so that multiple vtos won't collide
-    s = str[index];
-    index = (index + 1) & 7;
-    Q_snprintf(s, 32, "(%i %i %i)", (int)v[0], (int)v[1], (int)v[2]);
-    return s;
+    // scratch ring so that multiple vtos won't collide
+    return vtos_r(v, Q_ScratchBuffer(), MAX_STRING_CHARS);
 }
 
 vec3_t VEC_UP       = {0, -1, 0};
@@ -340,6 +393,136 @@ char *G_CopyString(const char *in) {
     return memcpy(G_Malloc(len), in, len);
 }
 
+#define LEVEL_CHUNK_SIZE    0x10000     // 64k
+#define LEVEL_ALIGN         8
+
+typedef struct level_chunk_s {
+    struct level_chunk_s    *next;
+    size_t                  size;
+    size_t                  used;
+    byte                    data[];
+} level_chunk_t;
+
+static level_chunk_t    *level_chunks;
+levelmem_t              level_mem;
+
+/**
+ * Allocate memory that lives until the next map load. Small requests are
+ * carved out of large TAG_LEVEL chunks instead of going to the server's
+ * zone allocator one at a time. Memory is zero filled.
+ *
+ * Nothing from here can be passed to gi.TagFree(), it all goes away at once
+ * in G_FreeLevelMemory().
+ */
+void *G_LevelAlloc(size_t size) {
+    level_chunk_t *c = level_chunks;
+    size_t chunksize;
+    void *p;
+
+    size = (size + LEVEL_ALIGN - 1) & ~(size_t)(LEVEL_ALIGN - 1);
+
+    if (!c || c->used + size > c->size) {
+        // big allocations get a chunk of their own
+        chunksize = max(size, LEVEL_CHUNK_SIZE);
+        c = gi.TagMalloc(sizeof(*c) + chunksize, TAG_LEVEL);    // zero filled
+        c->size = chunksize;
+
+        // keep filling the current chunk if this one won't have room left
+        if (level_chunks && chunksize == size) {
+            c->next = level_chunks->next;
+            level_chunks->next = c;
+        } else {
+            c->next = level_chunks;
+            level_chunks = c;
+        }
+        level_mem.chunks++;
+        level_mem.reserved += chunksize;
+    }
+
+    p = c->data + c->used;
+    c->used += size;
+
+    level_mem.allocs++;
+    level_mem.used += size;
+    return p;
+}
+
+#define INTERN_HASH_SIZE    1024
+
+typedef struct intern_s {
+    struct intern_s *next;
+    uint32_t        hash;
+    char            string[];
+} intern_t;
+
+static intern_t *intern_hash[INTERN_HASH_SIZE];
+
+/**
+ * Get the level lifetime copy of a string, identical strings share a single
+ * copy. Two interned strings are equal (case sensitive) if and only if their
+ * pointers are equal. Interned strings must never be modified.
+ */
+char *G_InternString(const char *s) {
+    intern_t *in;
+    uint32_t hash = 2166136261u;
+    const char *p;
+    size_t len;
+
+    // FNV-1a
+    for (p = s; *p; p++) {
+        hash = (hash ^ (byte) *p) * 16777619u;
+    }
+    len = p - s;
+
+    for (in = intern_hash[hash & (INTERN_HASH_SIZE - 1)]; in; in = in->next) {
+        if (in->hash == hash && !strcmp(in->string, s)) {
+            level_mem.intern_hits++;
+            return in->string;
+        }
+    }
+
+    in = G_LevelAlloc(sizeof(*in) + len + 1);
+    in->hash = hash;
+    memcpy(in->string, s, len + 1);
+    in->next = intern_hash[hash & (INTERN_HASH_SIZE - 1)];
+    intern_hash[hash & (INTERN_HASH_SIZE - 1)] = in;
+    level_mem.interned++;
+    return in->string;
+}
+
+/**
+ * Release everything allocated with TAG_LEVEL, including G_LevelAlloc() chunks
+ * and interned strings
+ */
+void G_FreeLevelMemory(void) {
+    gi.FreeTags(TAG_LEVEL);
+    level_chunks = NULL;
+    memset(intern_hash, 0, sizeof(intern_hash));
+    memset(&level_mem, 0, sizeof(level_mem));
+}
+
+/**
+ * Monotonic wall clock in microseconds, only useful for measuring intervals
+ */
+uint64_t G_Microseconds(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (!freq.QuadPart) {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000 +
+           (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
 /**
  * Initialize an entity
  */
@@ -379,6 +562,17 @@ edict_t *G_Spawn(void) {
     return e;
 }
 
+/**
+ * Flag a projectile that players clip against by hand (see
+ * G_TouchProjectiles) and count it against the owner's arena
+ */
+void G_AddProjectile(edict_t *e, edict_t *owner) {
+    e->flags |= FL_NOCLIP_PROJECTILE;
+    e->arena = (owner && owner->client) ? ARENA(owner)->number : 0;
+    level.projectiles.live[e->arena]++;
+    G_ClipLink(e);
+}
+
 /**
  * Marks the edict as free
  */
@@ -388,6 +582,13 @@ void G_FreeEdict(edict_t *ed) {
     if ((ed - g_edicts) <= (maxclients->value + BODY_QUEUE_SIZE)) {
         return;
     }
+
+    if (ed->flags & FL_NOCLIP_PROJECTILE) {
+        if (level.projectiles.live[ed->arena] > 0) {
+            level.projectiles.live[ed->arena]--;
+        }
+        G_ClipUnlink(ed);
+    }
     memset(ed, 0, sizeof(*ed));
     ed->classname = "freed";
     ed->freetime = level.time;
@@ -61,77 +61,205 @@ void G_FinishArenaVote(arena_t *a) {
 }
 
 /**
- *
+ * What a client currently adds to the global tally and to its arena's tally.
+ * Kept per client slot so a change can be applied as remove old + add new.
  */
-static int G_CalcVote(int *votes, arena_t *a) {
-    gclient_t *c;
-    uint8_t i;
-    int total = 0;
+typedef struct {
+    qboolean    eligible;
+    qboolean    admin;
+    int         global;     // -1 not voted, otherwise accepted
+    arena_t     *arena;     // arena tally counted in, NULL if none
+    int         local;      // -1 not voted, otherwise accepted
+} vote_mark_t;
 
-    votes[0] = votes[1] = 0;
+static vote_mark_t vote_marks[MAX_CLIENTS];
 
-    if (a && a->vote.proposal) {
-        for (i=0; i<a->client_count; i++) {
-            if (!a->clients[i]) {
-                continue;
-            }
+/**
+ * Work out what this client should contribute right now
+ */
+static void G_VoteMark(gclient_t *c, vote_mark_t *m) {
+    arena_t *a = c->pers.arena;
+    int i;
+
+    m->eligible = !c->pers.mvdspec && MAY_VOTE(c);
+    m->admin = c->pers.admin;
+    m->global = -1;
+    m->arena = NULL;
+    m->local = -1;
+
+    if (level.vote.proposal && c->level.vote.index == level.vote.index) {
+        m->global = c->level.vote.accepted;
+    }
 
-            if (!a->clients[i]->client) {
-                continue;
+    // only clients still in the arena's list count towards its votes
+    if (a && c->edict) {
+        for (i = 0; i < a->client_count; i++) {
+            if (a->clients[i] == c->edict) {
+                m->arena = a;
+                break;
             }
+        }
+    }
+    if (m->arena && a->vote.proposal && c->level.vote.index == a->vote.index) {
+        m->local = c->level.vote.accepted;
+    }
+}
 
-            c = a->clients[i]->client;
+/**
+ *
+ */
+static void G_VoteTally(vote_tally_t *t, const vote_mark_t *m, int vote, int delta) {
+    if (!m->eligible) {
+        return;
+    }
+    t->eligible += delta;
+    if (vote < 0) {
+        return;
+    }
+    if (m->admin) {
+        t->admin[vote] += delta;
+    } else {
+        t->votes[vote] += delta;
+    }
+}
 
-            if (c->pers.mvdspec) {
-                continue;
-            }
+/**
+ *
+ */
+static void G_VoteApply(const vote_mark_t *m, int delta) {
+    G_VoteTally(&level.vote.tally, m, m->global, delta);
+    if (m->arena) {
+        G_VoteTally(&m->arena->vote.tally, m, m->local, delta);
+    }
+}
 
-            if (!MAY_VOTE(c)) {
-                continue; // don't count spectators
-            }
+/**
+ * Something that affects a client's vote changed (cast a vote, joined or left
+ * a team or arena, became admin, connected). Swap its old contribution for
+ * the new one.
+ */
+void G_UpdateVoteTally(gclient_t *c) {
+    vote_mark_t *m;
+    int num;
 
-            total++;
-            if (c->level.vote.index != a->vote.index) {
-                continue; // not voted yet
-            }
+    if (!c || !game.clients) {
+        return;
+    }
+    num = c - game.clients;
+    if (num < 0 || num >= game.maxclients) {
+        return;
+    }
 
-            if (c->pers.admin) {
-                // admin vote decides immediately
-                votes[c->level.vote.accepted    ] = game.maxclients;
-                votes[c->level.vote.accepted ^ 1] = 0;
-                break;
-            }
+    m = &vote_marks[num];
+    G_VoteApply(m, -1);
+    G_VoteMark(c, m);
+    G_VoteApply(m, 1);
+}
+
+/**
+ * Count every client from scratch. Needed whenever a new vote starts, since
+ * that changes which client vote indexes count.
+ */
+void G_RebuildVoteTally(void) {
+    arena_t *a;
+    int i;
 
-            // count normal vote
-            votes[c->level.vote.accepted]++;
+    memset(&level.vote.tally, 0, sizeof(level.vote.tally));
+    FOR_EACH_ARENA(a) {
+        memset(&a->vote.tally, 0, sizeof(a->vote.tally));
+    }
+    memset(vote_marks, 0, sizeof(vote_marks));
+
+    for (i = 0; i < game.maxclients; i++) {
+        G_VoteMark(&game.clients[i], &vote_marks[i]);
+        G_VoteApply(&vote_marks[i], 1);
+    }
+}
+
+/**
+ * Debug cross-check, the running counts should always match a full recount.
+ * The recount goes into a local tally, the running one is left as it is.
+ */
+static void G_VerifyVoteTally(arena_t *a) {
+    vote_tally_t count;
+    vote_tally_t *t = a ? &a->vote.tally : &level.vote.tally;
+    vote_mark_t m;
+    int i;
+
+    memset(&count, 0, sizeof(count));
+    for (i = 0; i < game.maxclients; i++) {
+        G_VoteMark(&game.clients[i], &m);
+        if (!a) {
+            G_VoteTally(&count, &m, m.global, 1);
+        } else if (m.arena == a) {
+            G_VoteTally(&count, &m, m.local, 1);
         }
-    } else {
-        for (c = game.clients; c < game.clients + game.maxclients; c++) {
-            if (c->pers.mvdspec) {
+    }
+
+    if (memcmp(&count, t, sizeof(count))) {
+        gi.dprintf("%s: %s tally drifted: eligible %d/%d yes %d/%d no %d/%d "
+                "admin yes %d/%d admin no %d/%d\n",
+                __func__, a ? a->name : "global",
+                t->eligible, count.eligible, t->votes[1], count.votes[1],
+                t->votes[0], count.votes[0], t->admin[1], count.admin[1],
+                t->admin[0], count.admin[0]);
+    }
+}
+
+/**
+ * The vote of the first admin who voted, in the order clients were always
+ * counted in: the arena's client list, or client slots for global votes
+ */
+static int G_FirstAdminVote(arena_t *a) {
+    gclient_t *c;
+    int i, n;
+
+    n = a ? a->client_count : game.maxclients;
+    for (i = 0; i < n; i++) {
+        if (a) {
+            if (!a->clients[i] || !a->clients[i]->client) {
                 continue;
             }
-            if (!MAY_VOTE(c)) {
-                continue; // don't count spectators
-            }
+            c = a->clients[i]->client;
+        } else {
+            c = &game.clients[i];
+        }
+        if (c->pers.mvdspec || !MAY_VOTE(c) || !c->pers.admin) {
+            continue;
+        }
+        if (c->level.vote.index == (a ? a->vote.index : level.vote.index)) {
+            return c->level.vote.accepted;
+        }
+    }
+    return -1;
+}
 
-            total++;
-            if (c->level.vote.index != level.vote.index) {
-                continue; // not voted yet
-            }
+/**
+ *
+ */
+static int G_CalcVote(int *votes, arena_t *a) {
+    vote_tally_t *t;
+    int admin;
 
-            if (c->pers.admin) {
-                // admin vote decides immediately
-                votes[c->level.vote.accepted    ] = game.maxclients;
-                votes[c->level.vote.accepted ^ 1] = 0;
-                break;
-            }
+    if (!(a && a->vote.proposal)) {
+        a = NULL;
+    }
+    if (DEBUG) {
+        G_VerifyVoteTally(a);
+    }
+    t = a ? &a->vote.tally : &level.vote.tally;
 
-            // count normal vote
-            votes[c->level.vote.accepted]++;
-        }
+    // admin vote decides immediately, the first admin to be counted wins
+    admin = (t->admin[0] || t->admin[1]) ? G_FirstAdminVote(a) : -1;
+    if (admin >= 0) {
+        votes[admin] = game.maxclients;
+        votes[admin ^ 1] = 0;
+    } else {
+        votes[0] = t->votes[0];
+        votes[1] = t->votes[1];
     }
 
-    return total;
+    return t->eligible;
 }
 
 /**
@@ -384,16 +512,18 @@ qboolean G_CheckArenaVote(arena_t *a) {
 
             memcpy(a->ammo, a->vote.items, sizeof(a->ammo));
             memcpy(a->infinite, a->vote.infinite, sizeof(a->infinite));
+            G_BuildLoadout(a);
 
             G_RefillPlayers(a);
-            G_UpdatePlayerStatusBars(a);
+            G_ArenaQueueWork(a, ARENA_WORK_STATUSBARS);
             G_bprintf(a, PRINT_HIGH, "Local vote passed: weapons changed to '%s'\n", G_WeaponFlagsToString(a));
             break;
 
         case VOTE_DAMAGE:
             a->modified = qtrue;
             a->damage_flags = a->vote.value;
-            G_bprintf(a, PRINT_HIGH, "Local vote passed: damage protection changed to '%s'\n", G_DamageFlagsToString(a->damage_flags));
+            G_BuildLoadout(a);
+            G_bprintf(a, PRINT_HIGH, "Local vote passed: damage protection changed to '%s'\n", a->loadout.damage);
             break;
 
         case VOTE_RESET:
@@ -545,6 +675,7 @@ void Cmd_CastVote_f(edict_t *ent, qboolean accepted) {
 
     ent->client->level.vote.index = (ARENA(ent)->vote.proposal) ? ARENA(ent)->vote.index : level.vote.index;
     ent->client->level.vote.accepted = accepted;
+    G_UpdateVoteTally(ent->client);
 
     G_CheckVote();
     G_CheckArenaVote(ARENA(ent));
@@ -1053,6 +1184,7 @@ void Cmd_Vote_f(edict_t *ent) {
 
     ent->client->level.vote.accepted = qtrue;
     ent->client->level.vote.count++;
+    G_RebuildVoteTally();
 
     // decide vote immediately
     if (!G_CheckVote() && !G_CheckArenaVote(a)) {
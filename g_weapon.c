@@ -20,124 +20,148 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 #include "g_local.h"
 
 /**
- * This is an internal support routine used for bullet/pellet based weapons.
+ * Trace a bullet from start towards end, bending it and making a bubble trail
+ * if it goes through water. Returns where it stopped.
  */
-static void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int te_impact, int hspread, int vspread, int mod) {
+static trace_t fire_lead_trace(edict_t *self, vec3_t start, vec3_t end, int hspread, int vspread) {
     trace_t     tr;
     vec3_t      dir;
     vec3_t      forward, right, up;
-    vec3_t      end;
     float       r;
     float       u;
     vec3_t      water_start;
     qboolean    water = qfalse;
     int         content_mask = MASK_SHOT | MASK_WATER;
 
-    tr = gi.trace(self->s.origin, NULL, NULL, start, self, MASK_SHOT);
-    if (!(tr.fraction < 1.0)) {
-        vectoangles(aimdir, dir);
-        AngleVectors(dir, forward, right, up);
-
-        r = crandom() * hspread;
-        u = crandom() * vspread;
-        VectorMA(start, 8192, forward, end);
-        VectorMA(end, r, right, end);
-        VectorMA(end, u, up, end);
-
-        if (gi.pointcontents(start) & MASK_WATER) {
-            water = qtrue;
-            VectorCopy(start, water_start);
-            content_mask &= ~MASK_WATER;
-        }
+    if (gi.pointcontents(start) & MASK_WATER) {
+        water = qtrue;
+        VectorCopy(start, water_start);
+        content_mask &= ~MASK_WATER;
+    }
 
-        tr = gi.trace(start, NULL, NULL, end, self, content_mask);
-
-        // see if we hit water
-        if (tr.contents & MASK_WATER) {
-            int     color;
-
-            water = qtrue;
-            VectorCopy(tr.endpos, water_start);
-
-            if (!VectorCompare(start, tr.endpos)) {
-                if (tr.contents & CONTENTS_WATER) {
-                    if (strcmp(tr.surface->name, "*brwater") == 0) {
-                        color = SPLASH_BROWN_WATER;
-                    } else {
-                        color = SPLASH_BLUE_WATER;
-                    }
-                } else if (tr.contents & CONTENTS_SLIME) {
-                    color = SPLASH_SLIME;
-                } else if (tr.contents & CONTENTS_LAVA) {
-                    color = SPLASH_LAVA;
-                } else {
-                    color = SPLASH_UNKNOWN;
-                }
+    tr = gi.trace(start, NULL, NULL, end, self, content_mask);
+
+    // see if we hit water
+    if (tr.contents & MASK_WATER) {
+        int     color;
+
+        water = qtrue;
+        VectorCopy(tr.endpos, water_start);
 
-                if (color != SPLASH_UNKNOWN) {
-                    gi.WriteByte(SVC_TEMP_ENTITY);
-                    gi.WriteByte(TE_SPLASH);
-                    gi.WriteByte(8);
-                    gi.WritePosition(tr.endpos);
-                    gi.WriteDir(tr.plane.normal);
-                    gi.WriteByte(color);
-                    gi.multicast(tr.endpos, MULTICAST_PVS);
+        if (!VectorCompare(start, tr.endpos)) {
+            if (tr.contents & CONTENTS_WATER) {
+                if (strcmp(tr.surface->name, "*brwater") == 0) {
+                    color = SPLASH_BROWN_WATER;
+                } else {
+                    color = SPLASH_BLUE_WATER;
                 }
+            } else if (tr.contents & CONTENTS_SLIME) {
+                color = SPLASH_SLIME;
+            } else if (tr.contents & CONTENTS_LAVA) {
+                color = SPLASH_LAVA;
+            } else {
+                color = SPLASH_UNKNOWN;
+            }
 
-                // change bullet's course when it enters water
-                VectorSubtract(end, start, dir);
-                vectoangles(dir, dir);
-                AngleVectors(dir, forward, right, up);
-                r = crandom() * hspread * 2;
-                u = crandom() * vspread * 2;
-                VectorMA(water_start, 8192, forward, end);
-                VectorMA(end, r, right, end);
-                VectorMA(end, u, up, end);
+            if (color != SPLASH_UNKNOWN) {
+                G_WriteByte(SVC_TEMP_ENTITY);
+                G_WriteByte(TE_SPLASH);
+                G_WriteByte(8);
+                G_WritePosition(tr.endpos);
+                G_WriteDir(tr.plane.normal);
+                G_WriteByte(color);
+                G_ArenaMulticast(tr.endpos, MULTICAST_PVS, G_EdictArena(self));
             }
 
-            // re-trace ignoring water this time
-            tr = gi.trace(water_start, NULL, NULL, end, self, MASK_SHOT);
+            // change bullet's course when it enters water
+            VectorSubtract(end, start, dir);
+            vectoangles(dir, dir);
+            AngleVectors(dir, forward, right, up);
+            r = crandom() * hspread * 2;
+            u = crandom() * vspread * 2;
+            VectorMA(water_start, 8192, forward, end);
+            VectorMA(end, r, right, end);
+            VectorMA(end, u, up, end);
         }
-    }
 
-    // send gun puff / flash
-    if (!((tr.surface) && (tr.surface->flags & SURF_SKY))) {
-        if (tr.fraction < 1.0) {
-            if (tr.ent->takedamage) {
-                T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, DAMAGE_BULLET, mod);
-            } else {
-                if (strncmp(tr.surface->name, "sky", 3) != 0) {
-                    gi.WriteByte(SVC_TEMP_ENTITY);
-                    gi.WriteByte(te_impact);
-                    gi.WritePosition(tr.endpos);
-                    gi.WriteDir(tr.plane.normal);
-                    gi.multicast(tr.endpos, MULTICAST_PVS);
-                }
-            }
-        }
+        // re-trace ignoring water this time
+        tr = gi.trace(water_start, NULL, NULL, end, self, MASK_SHOT);
     }
 
     // if went through water, determine where the end and make a bubble trail
     if (water) {
+        trace_t tr2;
         vec3_t  pos;
 
         VectorSubtract(tr.endpos, water_start, dir);
         VectorNormalize(dir);
         VectorMA(tr.endpos, -2, dir, pos);
         if (gi.pointcontents(pos) & MASK_WATER) {
-            VectorCopy(pos, tr.endpos);
+            VectorCopy(pos, tr2.endpos);
         } else {
-            tr = gi.trace(pos, NULL, NULL, water_start, tr.ent, MASK_WATER);
+            tr2 = gi.trace(pos, NULL, NULL, water_start, tr.ent, MASK_WATER);
         }
 
-        VectorAdd(water_start, tr.endpos, pos);
+        VectorAdd(water_start, tr2.endpos, pos);
         VectorScale(pos, 0.5, pos);
 
-        gi.WriteByte(SVC_TEMP_ENTITY);
-        gi.WriteByte(TE_BUBBLETRAIL);
-        gi.WritePosition(water_start);
-        gi.WritePosition(tr.endpos);
-        gi.multicast(pos, MULTICAST_PVS);
+        G_WriteByte(SVC_TEMP_ENTITY);
+        G_WriteByte(TE_BUBBLETRAIL);
+        G_WritePosition(water_start);
+        G_WritePosition(tr2.endpos);
+        G_ArenaMulticast(pos, MULTICAST_PVS, G_EdictArena(self));
+    }
+
+    return tr;
+}
+
+/**
+ * Pick a random point in the spread cone around aimdir
+ */
+static void fire_lead_end(vec3_t start, vec3_t aimdir, int hspread, int vspread, vec3_t end) {
+    vec3_t      dir;
+    vec3_t      forward, right, up;
+    float       r;
+    float       u;
+
+    vectoangles(aimdir, dir);
+    AngleVectors(dir, forward, right, up);
+
+    r = crandom() * hspread;
+    u = crandom() * vspread;
+    VectorMA(start, 8192, forward, end);
+    VectorMA(end, r, right, end);
+    VectorMA(end, u, up, end);
+}
+
+/**
+ * This is an internal support routine used for bullet/pellet based weapons.
+ */
+static void fire_lead(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int te_impact, int hspread, int vspread, int mod) {
+    trace_t     tr;
+    vec3_t      end;
+
+    tr = gi.trace(self->s.origin, NULL, NULL, start, self, MASK_SHOT);
+    if (!(tr.fraction < 1.0)) {
+        fire_lead_end(start, aimdir, hspread, vspread, end);
+        tr = fire_lead_trace(self, start, end, hspread, vspread);
+    }
+
+    // send gun puff / flash
+    if (!((tr.surface) && (tr.surface->flags & SURF_SKY))) {
+        if (tr.fraction < 1.0) {
+            if (tr.ent->takedamage) {
+                T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, DAMAGE_BULLET, mod);
+            } else {
+                if (strncmp(tr.surface->name, "sky", 3) != 0) {
+                    G_WriteByte(SVC_TEMP_ENTITY);
+                    G_WriteByte(te_impact);
+                    G_WritePosition(tr.endpos);
+                    G_WriteDir(tr.plane.normal);
+                    G_ArenaMulticast(tr.endpos, MULTICAST_PVS, G_EdictArena(self));
+                }
+            }
+        }
     }
 }
 
@@ -149,15 +173,246 @@ void fire_bullet(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kic
     fire_lead(self, start, aimdir, damage, kick, TE_GUNSHOT, hspread, vspread, mod);
 }
 
+#define MAX_PELLETS         32
+#define PELLET_MARK_EPSILON 4       // impacts closer than this are drawn once
+#define PELLET_MARK_GROUP   64      // impacts this close share a message
+#define PELLET_MARK_SIZE    4       // temp entities per message
+
+typedef struct {
+    edict_t     *ent;
+    int         damage;
+    int         kick;
+    vec3_t      point;
+    vec3_t      normal;
+} pellet_hit_t;
+
+typedef struct {
+    vec3_t      pos;
+    vec3_t      normal;
+    qboolean    sent;
+} pellet_mark_t;
+
+typedef struct {
+    pellet_hit_t    hits[MAX_PELLETS];
+    int             numhits;
+    pellet_mark_t   marks[MAX_PELLETS];
+    int             nummarks;
+} pellet_batch_t;
+
+/**
+ * Remember a pellet hit, dealt after every pellet is resolved
+ */
+static void fire_pellet_damage(pellet_batch_t *b, edict_t *ent, vec3_t point, vec3_t normal, int damage, int kick) {
+    pellet_hit_t *h = &b->hits[b->numhits++];
+
+    h->ent = ent;
+    h->damage = damage;
+    h->kick = kick;
+    VectorCopy(point, h->point);
+    VectorCopy(normal, h->normal);
+}
+
+/**
+ * Remember a wall impact unless one is already drawn right there
+ */
+static void fire_pellet_mark(pellet_batch_t *b, vec3_t pos, vec3_t normal) {
+    pellet_mark_t *m;
+    vec3_t v;
+    int i;
+
+    for (i = 0; i < b->nummarks; i++) {
+        m = &b->marks[i];
+        VectorSubtract(m->pos, pos, v);
+        if (VectorCompare(m->normal, normal) &&
+                DotProduct(v, v) < PELLET_MARK_EPSILON * PELLET_MARK_EPSILON) {
+            return;
+        }
+    }
+
+    m = &b->marks[b->nummarks++];
+    VectorCopy(pos, m->pos);
+    VectorCopy(normal, m->normal);
+    m->sent = qfalse;
+}
+
+/**
+ * Resolve what a pellet stopped at, the same way fire_lead() does
+ */
+static void fire_pellet_result(pellet_batch_t *b, trace_t *tr, int damage, int kick) {
+    if (tr->surface && (tr->surface->flags & SURF_SKY)) {
+        return;
+    }
+    if (!(tr->fraction < 1.0)) {
+        return;
+    }
+    if (tr->ent->takedamage) {
+        fire_pellet_damage(b, tr->ent, tr->endpos, tr->plane.normal, damage, kick);
+    } else if (!tr->surface || strncmp(tr->surface->name, "sky", 3) != 0) {
+        fire_pellet_mark(b, tr->endpos, tr->plane.normal);
+    }
+}
+
+/**
+ * Send the wall impacts, packing those close enough to share a PVS check
+ * into one message
+ */
+static void fire_pellet_marks(edict_t *self, pellet_batch_t *b) {
+    pellet_mark_t *m, *first;
+    arena_t *arena = G_EdictArena(self);
+    vec3_t v;
+    int i, j, n;
+
+    for (i = 0; i < b->nummarks; i++) {
+        first = &b->marks[i];
+        if (first->sent) {
+            continue;
+        }
+
+        n = 0;
+        for (j = i; j < b->nummarks && n < PELLET_MARK_SIZE; j++) {
+            m = &b->marks[j];
+            if (m->sent) {
+                continue;
+            }
+            VectorSubtract(m->pos, first->pos, v);
+            if (DotProduct(v, v) > PELLET_MARK_GROUP * PELLET_MARK_GROUP) {
+                continue;
+            }
+            G_WriteByte(SVC_TEMP_ENTITY);
+            G_WriteByte(TE_SHOTGUN);
+            G_WritePosition(m->pos);
+            G_WriteDir(m->normal);
+            m->sent = qtrue;
+            n++;
+        }
+        G_ArenaMulticast(first->pos, MULTICAST_PVS, arena);
+    }
+}
+
 /**
  * Shoots shotgun pellets.  Used by shotgun and super shotgun.
+ *
+ * Every pellet is traced against the world only, then all of them are
+ * checked against the bbox entities found by one query around the whole
+ * spread. Each hit is still its own T_Damage so armor absorbs per pellet
+ * exactly as before. Pellets that touch water take the regular fire_lead()
+ * path.
  */
 void fire_shotgun(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick, int hspread, int vspread, int count, int mod) {
-    int     i;
+    static pellet_batch_t batch;
+    static trace_t pellets[MAX_PELLETS];
+    qboolean    resolved[MAX_PELLETS];
+    qboolean    inwater;
+    edict_t     *touch[MAX_EDICTS];
+    edict_t     *cand[MAX_EDICTS];
+    vec3_t      end, delta, mins, maxs, bmins, bmaxs, normal;
+    trace_t     tr;
+    edict_t     *e;
+    int         mask;
+    int         i, j, num, numcand;
+    float       frac, best;
 
-    for (i = 0; i < count; i++) {
+    // odd counts beyond the batch size just go one by one
+    for (; count > MAX_PELLETS; count--) {
         fire_lead(self, start, aimdir, damage, kick, TE_SHOTGUN, hspread, vspread, mod);
     }
+
+    batch.numhits = 0;
+    batch.nummarks = 0;
+
+    tr = gi.trace(self->s.origin, NULL, NULL, start, self, MASK_SHOT);
+    if (tr.fraction < 1.0) {
+        // muzzle is inside something, every pellet hits it
+        for (i = 0; i < count; i++) {
+            fire_pellet_result(&batch, &tr, damage, kick);
+        }
+        goto done;
+    }
+
+    // pass 1: the world, bbox entities have CONTENTS_MONSTER
+    mask = (MASK_SHOT | MASK_WATER) & ~(CONTENTS_MONSTER | CONTENTS_DEADMONSTER);
+    inwater = (gi.pointcontents(start) & MASK_WATER) ? qtrue : qfalse;
+    VectorCopy(start, mins);
+    VectorCopy(start, maxs);
+    for (i = 0; i < count; i++) {
+        fire_lead_end(start, aimdir, hspread, vspread, end);
+        if (!inwater) {
+            pellets[i] = gi.trace(start, NULL, NULL, end, self, mask);
+            resolved[i] = (pellets[i].contents & MASK_WATER) ? qtrue : qfalse;
+        } else {
+            resolved[i] = qtrue;
+        }
+        if (resolved[i]) {
+            pellets[i] = fire_lead_trace(self, start, end, hspread, vspread);
+            continue;
+        }
+        AddPointToBounds(pellets[i].endpos, mins, maxs);
+    }
+
+    // pass 2: entities anywhere in the spread
+    for (i = 0; i < 3; i++) {
+        mins[i] -= 1;
+        maxs[i] += 1;
+    }
+    numcand = 0;
+    num = gi.BoxEdicts(mins, maxs, touch, MAX_EDICTS, AREA_SOLID);
+    for (i = 0; i < num; i++) {
+        e = touch[i];
+        if (e == self || e->solid != SOLID_BBOX) {
+            continue;
+        }
+        if (e->owner == self || (self->owner && self->owner == e)) {
+            continue;   // trace passent rules
+        }
+        cand[numcand++] = e;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (resolved[i]) {
+            fire_pellet_result(&batch, &pellets[i], damage, kick);
+            continue;
+        }
+
+        VectorSubtract(pellets[i].endpos, start, delta);
+        best = 2;
+        e = NULL;
+        for (j = 0; j < numcand; j++) {
+            VectorAdd(cand[j]->s.origin, cand[j]->mins, bmins);
+            VectorAdd(cand[j]->s.origin, cand[j]->maxs, bmaxs);
+            if (!G_RayBox(start, delta, bmins, bmaxs, &frac, normal)) {
+                continue;
+            }
+            if (frac < best) {
+                best = frac;
+                e = cand[j];
+                VectorCopy(normal, tr.plane.normal);
+            }
+        }
+
+        if (e) {
+            if (VectorCompare(tr.plane.normal, vec3_origin)) {
+                VectorNormalize2(delta, tr.plane.normal);
+                VectorInverse(tr.plane.normal);
+            }
+            tr.ent = e;
+            tr.fraction = best * pellets[i].fraction;
+            tr.surface = NULL;
+            VectorMA(start, best, delta, tr.endpos);
+            fire_pellet_result(&batch, &tr, damage, kick);
+        } else {
+            fire_pellet_result(&batch, &pellets[i], damage, kick);
+        }
+    }
+
+done:
+    for (i = 0; i < batch.numhits; i++) {
+        pellet_hit_t *h = &batch.hits[i];
+
+        if (h->ent->inuse && h->ent->takedamage) {
+            T_Damage(h->ent, self, self, aimdir, h->point, h->normal, h->damage, h->kick, DAMAGE_BULLET, mod);
+        }
+    }
+    fire_pellet_marks(self, &batch);
 }
 
 /**
@@ -185,15 +440,15 @@ void blaster_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *s
         T_Damage(other, self, self->owner, self->velocity, self->s.origin, plane->normal, self->dmg, 1, DAMAGE_ENERGY, mod);
         G_EndDamage();
     } else {
-        gi.WriteByte(SVC_TEMP_ENTITY);
-        gi.WriteByte(TE_BLASTER);
-        gi.WritePosition(self->s.origin);
+        G_WriteByte(SVC_TEMP_ENTITY);
+        G_WriteByte(TE_BLASTER);
+        G_WritePosition(self->s.origin);
         if (!plane) {
-            gi.WriteDir(vec3_origin);
+            G_WriteDir(vec3_origin);
         } else {
-            gi.WriteDir(plane->normal);
+            G_WriteDir(plane->normal);
         }
-        gi.multicast(self->s.origin, MULTICAST_PVS);
+        G_ArenaMulticast(self->s.origin, MULTICAST_PVS, G_EdictArena(self));
     }
     G_FreeEdict(self);
 }
@@ -221,12 +476,11 @@ void fire_blaster(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
     bolt->movetype = MOVETYPE_FLYMISSILE;
     bolt->clipmask = MASK_SHOT;
     bolt->solid = SOLID_BBOX;
-    bolt->flags = FL_NOCLIP_PROJECTILE;
     bolt->s.effects |= effect;
     VectorClear(bolt->mins);
     VectorClear(bolt->maxs);
-    bolt->s.modelindex = gi.modelindex("models/objects/laser/tris.md2");
-    bolt->s.sound = gi.soundindex("misc/lasfly.wav");
+    bolt->s.modelindex = level.models.laser;
+    bolt->s.sound = level.sounds.blaster_fly;
     bolt->owner = self;
     bolt->touch = blaster_touch;
     bolt->nextthink = level.framenum + 2 * HZ;
@@ -236,6 +490,7 @@ void fire_blaster(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed
     if (hyper) {
         bolt->spawnflags = 1;
     }
+    G_AddProjectile(bolt, self);
     gi.linkentity(bolt);
 
     tr = gi.trace(self->s.origin, NULL, NULL, bolt->s.origin, bolt, MASK_SHOT);
@@ -285,22 +540,22 @@ static void Grenade_Explode(edict_t *ent) {
     G_EndDamage();
 
     VectorMA(ent->s.origin, -0.02, ent->velocity, origin);
-    gi.WriteByte(SVC_TEMP_ENTITY);
+    G_WriteByte(SVC_TEMP_ENTITY);
     if (ent->waterlevel) {
         if (ent->groundentity) {
-            gi.WriteByte(TE_GRENADE_EXPLOSION_WATER);
+            G_WriteByte(TE_GRENADE_EXPLOSION_WATER);
         } else {
-            gi.WriteByte(TE_ROCKET_EXPLOSION_WATER);
+            G_WriteByte(TE_ROCKET_EXPLOSION_WATER);
         }
     } else {
         if (ent->groundentity) {
-            gi.WriteByte(TE_GRENADE_EXPLOSION);
+            G_WriteByte(TE_GRENADE_EXPLOSION);
         } else {
-            gi.WriteByte(TE_ROCKET_EXPLOSION);
+            G_WriteByte(TE_ROCKET_EXPLOSION);
         }
     }
-    gi.WritePosition(origin);
-    gi.multicast(ent->s.origin, MULTICAST_PHS);
+    G_WritePosition(origin);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PHS, G_EdictArena(ent));
     G_FreeEdict(ent);
 }
 
@@ -320,12 +575,12 @@ static void Grenade_Touch(edict_t *ent, edict_t *other, cplane_t *plane, csurfac
     if (!other->takedamage) {
         if (ent->spawnflags & 1) {
             if (random() > 0.5) {
-                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/hgrenb1a.wav"), 1, ATTN_NORM, 0);
+                gi.sound(ent, CHAN_VOICE, level.sounds.hgrenade_bounce[0], 1, ATTN_NORM, 0);
             } else {
-                gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/hgrenb2a.wav"), 1, ATTN_NORM, 0);
+                gi.sound(ent, CHAN_VOICE, level.sounds.hgrenade_bounce[1], 1, ATTN_NORM, 0);
             }
         } else {
-            gi.sound(ent, CHAN_VOICE, gi.soundindex("weapons/grenlb1b.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_VOICE, level.sounds.grenade_bounce, 1, ATTN_NORM, 0);
         }
         return;
     }
@@ -358,14 +613,14 @@ void fire_grenade(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int sp
     grenade->s.effects |= EF_GRENADE;
     VectorClear(grenade->mins);
     VectorClear(grenade->maxs);
-    grenade->s.modelindex = gi.modelindex("models/objects/grenade/tris.md2");
+    grenade->s.modelindex = level.models.grenade;
     grenade->owner = self;
     grenade->touch = Grenade_Touch;
     grenade->nextthink = level.framenum + timer;
     grenade->think = Grenade_Explode;
     grenade->dmg = damage;
     grenade->dmg_radius = damage_radius;
-    grenade->classname = "grenade";
+    grenade->classname = level.classnames.grenade;
 
     gi.linkentity(grenade);
 }
@@ -394,7 +649,7 @@ void fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
     grenade->s.effects |= EF_GRENADE;
     VectorClear(grenade->mins);
     VectorClear(grenade->maxs);
-    grenade->s.modelindex = gi.modelindex("models/objects/grenade2/tris.md2");
+    grenade->s.modelindex = level.models.hgrenade;
     grenade->owner = self;
     grenade->touch = Grenade_Touch;
     grenade->nextthink = level.framenum + timer;
@@ -407,12 +662,12 @@ void fire_grenade2(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int s
     } else {
         grenade->spawnflags = 1;
     }
-    grenade->s.sound = gi.soundindex("weapons/hgrenc1b.wav");
+    grenade->s.sound = level.sounds.hgrenade_tick;
 
     if (timer <= 0) {
         Grenade_Explode(grenade);
     } else {
-        gi.sound(self, CHAN_WEAPON, gi.soundindex("weapons/hgrent1a.wav"), 1, ATTN_NORM, 0);
+        gi.sound(self, CHAN_WEAPON, level.sounds.hgrenade_timer, 1, ATTN_NORM, 0);
         gi.linkentity(grenade);
     }
 }
@@ -447,14 +702,14 @@ void rocket_touch(edict_t *ent, edict_t *other, cplane_t *plane, csurface_t *sur
 
     G_EndDamage();
 
-    gi.WriteByte(SVC_TEMP_ENTITY);
+    G_WriteByte(SVC_TEMP_ENTITY);
     if (ent->waterlevel) {
-        gi.WriteByte(TE_ROCKET_EXPLOSION_WATER);
+        G_WriteByte(TE_ROCKET_EXPLOSION_WATER);
     } else {
-        gi.WriteByte(TE_ROCKET_EXPLOSION);
+        G_WriteByte(TE_ROCKET_EXPLOSION);
     }
-    gi.WritePosition(origin);
-    gi.multicast(ent->s.origin, MULTICAST_PHS);
+    G_WritePosition(origin);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PHS, G_EdictArena(ent));
     G_FreeEdict(ent);
 }
 
@@ -476,7 +731,7 @@ void fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
     rocket->s.effects |= EF_ROCKET;
     VectorClear(rocket->mins);
     VectorClear(rocket->maxs);
-    rocket->s.modelindex = gi.modelindex("models/objects/rocket/tris.md2");
+    rocket->s.modelindex = level.models.rocket;
     rocket->owner = self;
     rocket->touch = rocket_touch;
     rocket->nextthink = level.framenum + 8000 * HZ / speed;
@@ -484,69 +739,118 @@ void fire_rocket(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed,
     rocket->dmg = damage;
     rocket->radius_dmg = radius_damage;
     rocket->dmg_radius = damage_radius;
-    rocket->s.sound = gi.soundindex("weapons/rockfly.wav");
+    rocket->s.sound = level.sounds.rocket_fly;
     rocket->classname = "rocket";
 
     gi.linkentity(rocket);
 }
 
+typedef struct {
+    edict_t     *ent;
+    float       frac;
+    vec3_t      normal;
+} railhit_t;
+
+/**
+ *
+ */
+static int RailHitCmp(const void *a, const void *b) {
+    const railhit_t *h1 = a, *h2 = b;
+
+    if (h1->frac < h2->frac) {
+        return -1;
+    }
+    return h1->frac > h2->frac;
+}
+
 /**
+ * The rail goes through players, monsters and other bbox entities (gibs,
+ * corpses) and stops at the world or a brush model.
  *
+ * Find the stopping point with world traces that don't clip against bbox
+ * entities, then test every bbox entity near the path against the segment
+ * and damage them front to back in one accounting batch.
  */
 void fire_rail(edict_t *self, vec3_t start, vec3_t aimdir, int damage, int kick) {
+    static railhit_t hits[MAX_EDICTS];
+    edict_t     *touch[MAX_EDICTS];
+    vec3_t      end, delta, mins, maxs, bmins, bmaxs, normal;
     vec3_t      from;
-    vec3_t      end;
     trace_t     tr;
-    edict_t     *ignore;
+    edict_t     *e;
     int         mask;
     qboolean    water;
-    int i;
+    int         i, num, numhits;
+    float       frac;
 
     VectorMA(start, 8192, aimdir, end);
     VectorCopy(start, from);
-    ignore = self;
     water = qfalse;
-    mask = MASK_SHOT | CONTENTS_SLIME | CONTENTS_LAVA;
-    for (i = 0; i < 100; i++) {
-        tr = gi.trace(from, NULL, NULL, end, ignore, mask);
 
-        if (tr.contents & (CONTENTS_SLIME | CONTENTS_LAVA)) {
-            mask &= ~(CONTENTS_SLIME | CONTENTS_LAVA);
-            water = qtrue;
-        } else {
-            //ZOID--added so rail goes through SOLID_BBOX entities (gibs, etc)
-            if ((tr.ent->svflags & SVF_MONSTER) || (tr.ent->client) ||
-                (tr.ent->solid == SOLID_BBOX)) {
-                ignore = tr.ent;
-            } else {
-                ignore = NULL;
-            }
+    // bbox entities have CONTENTS_MONSTER, leave them out of the world trace
+    mask = (MASK_SHOT | CONTENTS_SLIME | CONTENTS_LAVA) & ~(CONTENTS_MONSTER | CONTENTS_DEADMONSTER);
+    tr = gi.trace(from, NULL, NULL, end, self, mask);
+    if (tr.contents & (CONTENTS_SLIME | CONTENTS_LAVA)) {
+        mask &= ~(CONTENTS_SLIME | CONTENTS_LAVA);
+        water = qtrue;
+        VectorCopy(tr.endpos, from);
+        tr = gi.trace(from, NULL, NULL, end, self, mask);
+    }
 
-            if ((tr.ent != self) && (tr.ent->takedamage)) {
-                G_BeginDamage();
-                T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, 0, MOD_RAILGUN);
-                G_EndDamage();
-            }
+    // everything passed through on the way
+    VectorSubtract(tr.endpos, start, delta);
+    for (i = 0; i < 3; i++) {
+        mins[i] = min(start[i], tr.endpos[i]) - 1;
+        maxs[i] = max(start[i], tr.endpos[i]) + 1;
+    }
+
+    numhits = 0;
+    num = gi.BoxEdicts(mins, maxs, touch, MAX_EDICTS, AREA_SOLID);
+    for (i = 0; i < num; i++) {
+        e = touch[i];
+        if (e == self || e->solid != SOLID_BBOX) {
+            continue;
+        }
+        VectorAdd(e->s.origin, e->mins, bmins);
+        VectorAdd(e->s.origin, e->maxs, bmaxs);
+        if (!G_RayBox(start, delta, bmins, bmaxs, &frac, normal)) {
+            continue;
         }
+        hits[numhits].ent = e;
+        hits[numhits].frac = frac;
+        VectorCopy(normal, hits[numhits].normal);
+        numhits++;
+    }
+    qsort(hits, numhits, sizeof(hits[0]), RailHitCmp);
 
-        VectorCopy(tr.endpos, from);
-        if (!ignore) {
-            break;
+    G_BeginDamage();
+    for (i = 0; i < numhits; i++) {
+        e = hits[i].ent;
+        if (!e->inuse || !e->takedamage) {
+            continue;
         }
+        VectorMA(start, hits[i].frac, delta, from);
+        T_Damage(e, self, self, aimdir, from, hits[i].normal, damage, kick, 0, MOD_RAILGUN);
     }
 
+    // brush models that can be hurt stop the rail
+    if (tr.ent && tr.ent != self && tr.ent->takedamage) {
+        T_Damage(tr.ent, self, self, aimdir, tr.endpos, tr.plane.normal, damage, kick, 0, MOD_RAILGUN);
+    }
+    G_EndDamage();
+
     // send gun puff / flash
-    gi.WriteByte(SVC_TEMP_ENTITY);
-    gi.WriteByte(TE_RAILTRAIL);
-    gi.WritePosition(start);
-    gi.WritePosition(tr.endpos);
-    gi.multicast(self->s.origin, MULTICAST_PHS);
+    G_WriteByte(SVC_TEMP_ENTITY);
+    G_WriteByte(TE_RAILTRAIL);
+    G_WritePosition(start);
+    G_WritePosition(tr.endpos);
+    G_ArenaMulticast(self->s.origin, MULTICAST_PHS, G_EdictArena(self));
     if (water) {
-        gi.WriteByte(SVC_TEMP_ENTITY);
-        gi.WriteByte(TE_RAILTRAIL);
-        gi.WritePosition(start);
-        gi.WritePosition(tr.endpos);
-        gi.multicast(tr.endpos, MULTICAST_PHS);
+        G_WriteByte(SVC_TEMP_ENTITY);
+        G_WriteByte(TE_RAILTRAIL);
+        G_WritePosition(start);
+        G_WritePosition(tr.endpos);
+        G_ArenaMulticast(tr.endpos, MULTICAST_PHS, G_EdictArena(self));
     }
 }
 
@@ -585,10 +889,10 @@ void bfg_explode(edict_t *self) {
                 points = points * 0.5;
             }
 
-            gi.WriteByte(SVC_TEMP_ENTITY);
-            gi.WriteByte(TE_BFG_EXPLOSION);
-            gi.WritePosition(ent->s.origin);
-            gi.multicast(ent->s.origin, MULTICAST_PHS);
+            G_WriteByte(SVC_TEMP_ENTITY);
+            G_WriteByte(TE_BFG_EXPLOSION);
+            G_WritePosition(ent->s.origin);
+            G_ArenaMulticast(ent->s.origin, MULTICAST_PHS, G_EdictArena(self));
             G_BeginDamage();
             T_Damage(ent, self, self->owner, self->velocity, ent->s.origin, vec3_origin, (int)points, 0, DAMAGE_ENERGY, MOD_BFG_EFFECT);
             G_EndDamage();
@@ -624,28 +928,29 @@ void bfg_touch(edict_t *self, edict_t *other, cplane_t *plane, csurface_t *surf)
     T_RadiusDamage(self, self->owner, 200, other, 100, MOD_BFG_BLAST);
     G_EndDamage();
 
-    gi.sound(self, CHAN_VOICE, gi.soundindex("weapons/bfg__x1b.wav"), 1, ATTN_NORM, 0);
+    gi.sound(self, CHAN_VOICE, level.sounds.bfg_explode, 1, ATTN_NORM, 0);
     self->solid = SOLID_NOT;
     self->touch = NULL;
     VectorMA(self->s.origin, -1 * FRAMETIME, self->velocity, self->s.origin);
     VectorClear(self->velocity);
-    self->s.modelindex = gi.modelindex("sprites/s_bfg3.sp2");
+    self->s.modelindex = level.models.bfg_explode;
     self->s.frame = 0;
     self->s.sound = 0;
     self->s.effects &= ~EF_ANIM_ALLFAST;
     NEXT_KEYFRAME(self, bfg_explode);
     self->enemy = other;
 
-    gi.WriteByte(SVC_TEMP_ENTITY);
-    gi.WriteByte(TE_BFG_BIGEXPLOSION);
-    gi.WritePosition(self->s.origin);
-    gi.multicast(self->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_TEMP_ENTITY);
+    G_WriteByte(TE_BFG_BIGEXPLOSION);
+    G_WritePosition(self->s.origin);
+    G_ArenaMulticast(self->s.origin, MULTICAST_PVS, G_EdictArena(self));
 }
 
 /**
  *
  */
 void bfg_think(edict_t *self) {
+    edict_t *list[MAX_EDICTS];
     edict_t *ent;
     edict_t *ignore;
     vec3_t  point;
@@ -654,11 +959,13 @@ void bfg_think(edict_t *self) {
     vec3_t  end;
     int     dmg;
     trace_t tr;
+    int     i, num;
 
     dmg = 5;
 
-    ent = NULL;
-    while ((ent = findradius(ent, self->s.origin, 256)) != NULL) {
+    num = G_FindRadius(self->s.origin, 256, list, MAX_EDICTS);
+    for (i = 0; i < num; i++) {
+        ent = list[i];
         if (ent == self) {
             continue;
         }
@@ -671,7 +978,7 @@ void bfg_think(edict_t *self) {
             continue;
         }
 
-        if (!(ent->svflags & SVF_MONSTER) && (!ent->client) && (strcmp(ent->classname, "misc_explobox") != 0)) {
+        if (!(ent->svflags & SVF_MONSTER) && (!ent->client) && !(ent->flags & FL_BFG_TARGET)) {
             continue;
         }
 
@@ -699,13 +1006,13 @@ void bfg_think(edict_t *self) {
 
             // if we hit something that's not a monster or player we're done
             if (!(tr.ent->svflags & SVF_MONSTER) && (!tr.ent->client)) {
-                gi.WriteByte(SVC_TEMP_ENTITY);
-                gi.WriteByte(TE_LASER_SPARKS);
-                gi.WriteByte(4);
-                gi.WritePosition(tr.endpos);
-                gi.WriteDir(tr.plane.normal);
-                gi.WriteByte(self->s.skinnum);
-                gi.multicast(tr.endpos, MULTICAST_PVS);
+                G_WriteByte(SVC_TEMP_ENTITY);
+                G_WriteByte(TE_LASER_SPARKS);
+                G_WriteByte(4);
+                G_WritePosition(tr.endpos);
+                G_WriteDir(tr.plane.normal);
+                G_WriteByte(self->s.skinnum);
+                G_ArenaMulticast(tr.endpos, MULTICAST_PVS, G_EdictArena(self));
                 break;
             }
 
@@ -713,11 +1020,11 @@ void bfg_think(edict_t *self) {
             VectorCopy(tr.endpos, start);
         }
 
-        gi.WriteByte(SVC_TEMP_ENTITY);
-        gi.WriteByte(TE_BFG_LASER);
-        gi.WritePosition(self->s.origin);
-        gi.WritePosition(tr.endpos);
-        gi.multicast(self->s.origin, MULTICAST_PHS);
+        G_WriteByte(SVC_TEMP_ENTITY);
+        G_WriteByte(TE_BFG_LASER);
+        G_WritePosition(self->s.origin);
+        G_WritePosition(tr.endpos);
+        G_ArenaMulticast(self->s.origin, MULTICAST_PHS, G_EdictArena(self));
     }
     self->nextthink = level.framenum + FRAMEDIV;
 }
@@ -740,14 +1047,14 @@ void fire_bfg(edict_t *self, vec3_t start, vec3_t dir, int damage, int speed, fl
     bfg->s.effects |= EF_BFG | EF_ANIM_ALLFAST;
     VectorClear(bfg->mins);
     VectorClear(bfg->maxs);
-    bfg->s.modelindex = gi.modelindex("sprites/s_bfg1.sp2");
+    bfg->s.modelindex = level.models.bfg;
     bfg->owner = self;
     bfg->touch = bfg_touch;
     NEXT_KEYFRAME(bfg, bfg_think);
     bfg->radius_dmg = damage;
     bfg->dmg_radius = damage_radius;
     bfg->classname = "bfg blast";
-    bfg->s.sound = gi.soundindex("weapons/bfg__l1a.wav");
+    bfg->s.sound = level.sounds.bfg_fly;
     bfg->teammaster = bfg;
     bfg->teamchain = NULL;
 
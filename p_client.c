@@ -105,8 +105,9 @@ int G_UpdateRanks(void) {
  */
 void G_ScoreChanged(edict_t *ent) {
     char buffer[MAX_QPATH];
+    playerstats_t *stats = G_FindPlayerStats(ent);
     Q_snprintf(buffer, sizeof(buffer), "%5d",
-        ent->client->resp.damage_given);
+        stats ? stats->damage_given : 0);
     G_PrivateString(ent, PCS_DAMAGE, buffer);
 }
 
@@ -155,27 +156,28 @@ static const frag_t mod_to_frag[MOD_TOTAL] = {
  *
  */
 static void AccountItemKills(edict_t *ent) {
+    itemstat_t *items = G_PlayerStats(ent)->items;
     int index;
 
     if (ent->flags & FL_MEGAHEALTH) {
-        ent->client->resp.items[ITEM_HEALTH].kills++;
+        items[ITEM_HEALTH].kills++;
     }
     if (ent->client->quad_framenum > level.framenum) {
         // FIXME: should account based on inflictor?
-        ent->client->resp.items[ITEM_QUAD].kills++;
+        items[ITEM_QUAD].kills++;
     }
     if (ent->client->invincible_framenum > level.framenum) {
-        ent->client->resp.items[ITEM_INVULNERABILITY].kills++;
+        items[ITEM_INVULNERABILITY].kills++;
     }
 
     index = ArmorIndex(ent);
     if (index) {
-        ent->client->resp.items[index].kills++;
+        items[index].kills++;
     }
 
     index = PowerArmorIndex(ent);
     if (index) {
-        ent->client->resp.items[index].kills++;
+        items[index].kills++;
     }
 }
 
@@ -309,7 +311,7 @@ static void ClientObituary(edict_t *self, edict_t *inflictor, edict_t *attacker)
         if (self->client->pers.arena->state == ARENA_STATE_PLAY) {
             frag = mod_to_frag[mod];
             self->client->resp.score--;
-            self->client->resp.frags[frag].suicides++;
+            G_PlayerStats(self)->frags[frag].suicides++;
             self->enemy = NULL;
             G_ScoreChanged(self);
             G_UpdateRanks();
@@ -423,9 +425,9 @@ static void ClientObituary(edict_t *self, edict_t *inflictor, edict_t *attacker)
                 if (self->client->pers.arena->state == ARENA_STATE_PLAY) {
                     frag = mod_to_frag[mod];
                     attacker->client->resp.score++;
-                    attacker->client->resp.frags[frag].kills++;
+                    G_PlayerStats(attacker)->frags[frag].kills++;
                     self->client->resp.deaths++;
-                    self->client->resp.frags[frag].deaths++;
+                    G_PlayerStats(self)->frags[frag].deaths++;
                     AccountItemKills(attacker);
                 }
             }
@@ -439,7 +441,7 @@ static void ClientObituary(edict_t *self, edict_t *inflictor, edict_t *attacker)
     frag = mod_to_frag[mod];
     if (self->client->pers.arena->state == ARENA_STATE_PLAY) {
         self->client->resp.score--;
-        self->client->resp.frags[frag].suicides++;
+        G_PlayerStats(self)->frags[frag].suicides++;
     }
 
     G_ScoreChanged(self);
@@ -465,6 +467,7 @@ void G_BeginDamage(void) {
  * points = the amount of damage done
  */
 void G_AccountDamage(edict_t *targ, edict_t *inflictor, edict_t *attacker, int points) {
+    playerstats_t *stats;
     frag_t frag;
 
     if (!damaging) {
@@ -480,14 +483,19 @@ void G_AccountDamage(edict_t *targ, edict_t *inflictor, edict_t *attacker, int p
         return; // only care about weapons
     }
 
-    targ->client->resp.damage_recvd += points;
+    G_LogDamage(targ, attacker, points);
+
+    G_PlayerStats(targ)->damage_recvd += points;
     if (targ == attacker) {
         return; // no credit for shooting yourself
     }
 
+    stats = G_PlayerStats(attacker);
+    stats->damage_given += points;
+
     // don't count multiple damage as multiple hits (but railgun still counts)
     if (damaging == 1 || frag == FRAG_RAILGUN) {
-        attacker->client->resp.frags[frag].hits++;
+        stats->frags[frag].hits++;
     }
     damaging++;
     G_ScoreChanged(attacker);
@@ -598,6 +606,7 @@ void player_die(edict_t *self, edict_t *inflictor, edict_t *attacker, int damage
     if (!self->deadflag) {
         if (arena && team && arena->state >= ARENA_STATE_PLAY) {
             G_CountEveryone(arena);
+            G_LogKill(self, attacker);
         }
 
         self->client->respawn_framenum = level.framenum + 1 * HZ;
@@ -1019,8 +1028,6 @@ void G_RespawnPlayer(edict_t *ent) {
     total = G_UpdateRanks();
     if (total) {} // silence compiler warning
 
-    ent->client->resp.damage_given = 0;
-    ent->client->resp.damage_recvd = 0;
     ent->killer = NULL;
     ent->health = 0;
 
@@ -1216,7 +1223,7 @@ void PutClientInServer(edict_t *ent) {
 
     // clear playerstate values
     client->ps.fov = client->pers.fov;
-    client->ps.gunindex = gi.modelindex(client->weapon->view_model);
+    client->ps.gunindex = G_ItemViewModel(client->weapon);
 
     // clear entity state values
     ent->s.sound = 0;
@@ -1395,6 +1402,13 @@ void ClientBegin(edict_t *ent) {
         Cmd_Menu_f(ent);
     }
 
+    G_LogClientEvent(ent);
+
+    // back from a restart, put them where they were
+    if (!level.intermission_framenum && !ent->client->pers.mvdspec) {
+        G_RestoreClient(ent);
+    }
+
     // make sure all view stuff is valid
     ClientEndServerFrame(ent);
 
@@ -1659,6 +1673,7 @@ qboolean ClientConnect(edict_t *ent, char *userinfo) {
             ent->client->level.first_time = qfalse;
         }
     }
+    G_UpdateVoteTally(ent->client);
     return qtrue;
 }
 
@@ -1745,30 +1760,38 @@ static trace_t q_gameabi PM_trace(vec3_t start, vec3_t mins, vec3_t maxs, vec3_t
     return gi.trace(start, mins, maxs, end, pm_passent, pm_mask);
 }
 
+#define PROJECTILE_TOUCHES  10
+
 /**
- * An ugly hack that runs a trace against any FL_NOCLIP_PROJECTILE entities for
- * clipping purposes against players. This assumes that the ent will be freed
- * on touch or bad things will happen.
+ * An ugly hack that touches any FL_NOCLIP_PROJECTILE entities the player
+ * swept through for clipping purposes. This assumes that the ent will be
+ * freed on touch or bad things will happen.
+ *
+ * Only projectile boxes matter here, so this sweeps against the game side
+ * broadphase instead of tracing. Projectiles never leave the arena they were
+ * fired in, so nothing is done unless that arena or the world owns some.
  */
 static void G_TouchProjectiles(edict_t *ent, vec3_t start) {
-    edict_t *ignore;
-    trace_t tr;
-    int i;
+    clip_hit_t hits[PROJECTILE_TOUCHES];
+    edict_t *other;
+    int i, num;
 
-    ignore = ent;
-    for (i = 0; i < 10; i++) {
-        tr = gi.trace(start, ent->mins, ent->maxs, ent->s.origin,
-                      ignore, CONTENTS_MONSTER | CONTENTS_DEADMONSTER);
-        if (!tr.ent || tr.ent == world) {
-            continue;
-        }
-        VectorCopy(tr.endpos, start);
-        ignore = tr.ent;
+    level.projectiles.checks++;
+    if (!level.projectiles.live[0] && !level.projectiles.live[ARENA(ent)->number]) {
+        level.projectiles.skipped++;
+        return;
+    }
 
-        if (!(tr.ent->flags & FL_NOCLIP_PROJECTILE)) {
-            continue;
+    level.projectiles.tests++;
+    num = G_ClipMove(start, ent->mins, ent->maxs, ent->s.origin, ent,
+                     CLIP_PROJECTILES, hits, PROJECTILE_TOUCHES);
+    for (i = 0; i < num; i++) {
+        other = hits[i].ent;
+        if (!other->inuse || !(other->flags & FL_NOCLIP_PROJECTILE)) {
+            continue;   // freed by an earlier touch
         }
-        tr.ent->touch(tr.ent, ent, NULL, NULL);
+        level.projectiles.touches++;
+        other->touch(other, ent, NULL, NULL);
     }
 }
 
@@ -1782,10 +1805,13 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd) {
     int     i, j;
     pmove_t pm;
     vec3_t start;
+    uint64_t pmove_start;
 
     level.current_entity = ent;
     client = ent->client;
 
+    G_ClientPerfThink(client, ucmd->msec);
+
     client->level.cmd_angles[0] = SHORT2ANGLE(ucmd->angles[0]);
     client->level.cmd_angles[1] = SHORT2ANGLE(ucmd->angles[1]);
     client->level.cmd_angles[2] = SHORT2ANGLE(ucmd->angles[2]);
@@ -1850,7 +1876,9 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd) {
         pm.pointcontents = gi.pointcontents;
 
         // perform a pmove
+        pmove_start = G_Microseconds();
         gi.Pmove(&pm);
+        G_ClientPerfPmove(client, G_Microseconds() - pmove_start);
 
         // save results of pmove
         client->ps.pmove = pm.s;
@@ -1883,6 +1911,9 @@ void ClientThink(edict_t *ent, usercmd_t *ucmd) {
         } else {
             VectorCopy(pm.viewangles, client->v_angle);
             VectorCopy(pm.viewangles, client->ps.viewangles);
+
+            // build the view basis once for weapons, hud and view code
+            P_ViewVectors(client, NULL, NULL, NULL);
         }
 
         if (ent->movetype != MOVETYPE_NOCLIP) {
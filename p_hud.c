@@ -19,6 +19,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
 */
 #include "g_local.h"
 
+hudstats_t      hud_stats;
+
 /**
  * Compare players base on how much damage they've done.
  *
@@ -79,7 +81,7 @@ static size_t BuildScoreboard(char *buffer, gclient_t *client) {
     gclient_t   *ranks[MAX_CLIENTS];
     gclient_t   *c;
     time_t      t;
-    struct tm   *tm;
+    struct tm   tm;
 
     if (!client) {
         Q_snprintf(entry, sizeof(entry),
@@ -89,8 +91,10 @@ static size_t BuildScoreboard(char *buffer, gclient_t *client) {
     }
 
     t = time(NULL);
-    tm = localtime(&t);
-    len = strftime(status, sizeof(status), "[%Y-%m-%d %H:%M]", tm);
+    len = 0;
+    if (os_localtime(&t, &tm)) {
+        len = strftime(status, sizeof(status), "[%Y-%m-%d %H:%M]", &tm);
+    }
     if (len < 1) {
         strcpy(status, "???");
     }
@@ -204,7 +208,7 @@ void HighScoresMessage(void) {
     char    entry[MAX_STRING_CHARS];
     char    string[MAX_STRING_CHARS];
     char    date[MAX_QPATH];
-    struct tm   *tm;
+    struct tm   tm;
     score_t *s;
     size_t  total, len;
     int     i;
@@ -222,8 +226,10 @@ void HighScoresMessage(void) {
     for (i = 0; i < level.numscores; i++) {
         s = &level.scores[i];
 
-        tm = localtime(&s->time);
-        len = strftime(date, sizeof(date), "%Y-%m-%d", tm);
+        len = 0;
+        if (os_localtime(&s->time, &tm)) {
+            len = strftime(date, sizeof(date), "%Y-%m-%d", &tm);
+        }
         if (len < 1) {
             strcpy(date, "???");
         }
@@ -454,31 +460,33 @@ static qboolean visible(edict_t *self, edict_t *other, int mask){
 /**
  * Find the best player for the id view and return configstring index.
  *
- * Code below comes from OpenTDM.
+ * Code below comes from OpenTDM. Only the world and water stop the id trace,
+ * players along the way are found with the game side broadphase instead of
+ * retracing past each of them.
  */
 static edict_t *find_by_tracing(edict_t *ent) {
-    edict_t     *ignore;
+    clip_hit_t  hits[MAX_CLIENTS];
     vec3_t      forward;
     trace_t     tr;
-    vec3_t      start;
+    vec3_t      start, from;
     vec3_t      mins = { -4, -4, -4 };
     vec3_t      maxs = { 4, 4, 4 };
-    int         i;
+    edict_t     *other;
+    int         i, num;
     int         tracemask;
 
     VectorCopy(ent->s.origin, start);
     start[2] += ent->viewheight;
-    AngleVectors(ent->client->v_angle, forward, NULL, NULL);
+    P_ViewVectors(ent->client, forward, NULL, NULL);
     VectorScale(forward, 4096, forward);
     VectorAdd(ent->s.origin, forward, forward);
 
-    ignore = ent;
+    tracemask = CONTENTS_SOLID | MASK_WATER;
 
-    tracemask = CONTENTS_SOLID | CONTENTS_MONSTER | MASK_WATER;
-
-    // find best player through tracing
+    // find where the world stops the view
+    VectorCopy(start, from);
     for (i = 0; i < 10; i++) {
-        tr = gi.trace(start, mins, maxs, forward, ignore, tracemask);
+        tr = gi.trace(from, mins, maxs, forward, ent, tracemask);
 
         // entire move is inside water volume
         if (tr.allsolid && (tr.contents & MASK_WATER)) {
@@ -490,23 +498,23 @@ static edict_t *find_by_tracing(edict_t *ent) {
         if (tr.ent == world && tr.surface &&
             (tr.surface->flags & (SURF_TRANS33 | SURF_TRANS66))) {
             tracemask &= ~MASK_WATER;
-            VectorCopy(tr.endpos, start);
+            VectorCopy(tr.endpos, from);
             continue;
         }
+        break;
+    }
 
-        if (tr.ent == world || tr.fraction == 1.0f) {
-            break;
-        }
+    // find best player in front of that
+    num = G_ClipMove(start, mins, maxs, tr.endpos, ent, CLIP_PLAYERS, hits, MAX_CLIENTS);
+    for (i = 0; i < num; i++) {
+        other = hits[i].ent;
 
         // we hit something that's a player and it's alive!
         // note, we trace twice so we hit water planes
-        if (tr.ent && tr.ent->client && tr.ent->health > 0 &&
-            visible(tr.ent, ent, CONTENTS_SOLID | MASK_WATER)) {
-            return tr.ent;
+        if (other->client && other->health > 0 &&
+            visible(other, ent, CONTENTS_SOLID | MASK_WATER)) {
+            return other;
         }
-
-        VectorCopy(tr.endpos, start);
-        ignore = tr.ent;
     }
     return NULL;
 }
@@ -521,7 +529,7 @@ static edict_t *find_by_angles(edict_t *ent) {
     float       distance, bdistance = 0.0f;
     float       bd = 0.0f, d;
 
-    AngleVectors(ent->client->v_angle, forward, NULL, NULL);
+    P_ViewVectors(ent->client, forward, NULL, NULL);
     best = NULL;
 
     // if trace was unsuccessful, try guessing based on angles
@@ -596,60 +604,55 @@ int G_GetPlayerIdView(edict_t *ent, qboolean *teammate) {
 }
 
 /**
- * Set playerstats stats for each player.
- *
- * This is called every server frame
+ * Health, always the same icon
  */
-void G_SetStats(edict_t *ent) {
-    const gitem_t   *item;
-    int             index, cells;
-    int             power_armor_type;
-    qboolean        teammate = qfalse;
-    int             viewid = 0;
-
-    // health
+static int G_StatsHealth(edict_t *ent) {
     ent->client->ps.stats[STAT_HEALTH_ICON] = level.images.health;
     ent->client->ps.stats[STAT_HEALTH] = ent->health;
+    return 2;
+}
+
+/**
+ * Current weapon and the ammo it uses
+ */
+static int G_StatsAmmo(edict_t *ent) {
+    const gitem_t *item;
 
-    // ammo
     if (!ent->client->ammo_index /* || !ent->client->pers.inventory[ent->client->ammo_index] */) {
         ent->client->ps.stats[STAT_AMMO_ICON] = 0;
         ent->client->ps.stats[STAT_AMMO] = 0;
-    } else {
-        item = INDEX_ITEM(ent->client->ammo_index);
-        ent->client->ps.stats[STAT_AMMO_ICON] = gi.imageindex(item->icon);
-        ent->client->ps.stats[STAT_AMMO] = ent->client->inventory[ent->client->ammo_index];
-        ent->client->ps.stats[STAT_WEAPON_ICON] = gi.imageindex(ent->client->weapon->icon);
+        return 2;
     }
 
-    // armor
-    cells = 0;
-    power_armor_type = PowerArmorIndex(ent);
-    if (power_armor_type) {
-        cells = ent->client->inventory[ITEM_CELLS];
-        if (cells == 0) {
-            // ran out of cells for power armor
-            ent->flags &= ~FL_POWER_ARMOR;
-            gi.sound(ent, CHAN_ITEM, gi.soundindex("misc/power2.wav"), 1, ATTN_NORM, 0);
-            power_armor_type = 0;
-        }
-    }
+    item = INDEX_ITEM(ent->client->ammo_index);
+    ent->client->ps.stats[STAT_AMMO_ICON] = G_ItemIcon(item);
+    ent->client->ps.stats[STAT_AMMO] = ent->client->inventory[ent->client->ammo_index];
+    ent->client->ps.stats[STAT_WEAPON_ICON] = G_ItemIcon(ent->client->weapon);
+    return 3;
+}
 
-    index = ArmorIndex(ent);
+/**
+ * Regular armor, or power armor flashing with it
+ */
+static int G_StatsArmor(edict_t *ent, int power_armor_type, int index) {
     if (power_armor_type && (!index || ((level.framenum / FRAMEDIV) & 8))) {
         // flash between power armor and other armor icon
         ent->client->ps.stats[STAT_ARMOR_ICON] = level.images.powershield;
-        ent->client->ps.stats[STAT_ARMOR] = cells;
+        ent->client->ps.stats[STAT_ARMOR] = ent->client->inventory[ITEM_CELLS];
     } else if (index) {
-        item = INDEX_ITEM(index);
-        ent->client->ps.stats[STAT_ARMOR_ICON] = gi.imageindex(item->icon);
+        ent->client->ps.stats[STAT_ARMOR_ICON] = G_ItemIcon(INDEX_ITEM(index));
         ent->client->ps.stats[STAT_ARMOR] = ent->client->inventory[index];
     } else {
         ent->client->ps.stats[STAT_ARMOR_ICON] = 0;
         ent->client->ps.stats[STAT_ARMOR] = 0;
     }
+    return 2;
+}
 
-    // timer 1 (quad, enviro, breather)
+/**
+ * Timer 1 (quad, enviro, breather)
+ */
+static int G_StatsTimer(edict_t *ent) {
     if (ent->client->quad_framenum > level.framenum) {
         ent->client->ps.stats[STAT_TIMER_ICON] = level.images.quad;
         ent->client->ps.stats[STAT_TIMER] = (ent->client->quad_framenum - level.framenum) / HZ;
@@ -663,103 +666,267 @@ void G_SetStats(edict_t *ent) {
         ent->client->ps.stats[STAT_TIMER_ICON] = 0;
         ent->client->ps.stats[STAT_TIMER] = 0;
     }
+    return 2;
+}
 
-    // selected item
+/**
+ * Inventory item selected with invnext/invprev
+ */
+static int G_StatsSelected(edict_t *ent) {
     if (ent->client->selected_item == -1) {
         ent->client->ps.stats[STAT_SELECTED_ICON] = 0;
     } else {
-        item = INDEX_ITEM(ent->client->selected_item);
-        ent->client->ps.stats[STAT_SELECTED_ICON] = gi.imageindex(item->icon);
+        ent->client->ps.stats[STAT_SELECTED_ICON] = G_ItemIcon(INDEX_ITEM(ent->client->selected_item));
     }
-
     ent->client->ps.stats[STAT_SELECTED_ITEM] = ent->client->selected_item;
+    return 2;
+}
 
-    // layouts
-    ent->client->ps.stats[STAT_LAYOUTS] = 0;
+/**
+ * Frags, damage or points depending on the arena's score mode
+ */
+static int G_StatsScore(edict_t *ent, int score) {
+    ent->client->ps.stats[STAT_FRAGS] = score;
+    return 1;
+}
+
+/**
+ * Layouts, spectator/chase state, countdown and the player id view. The id
+ * view depends on where everyone is standing so this runs every frame.
+ */
+static int G_StatsView(edict_t *ent) {
+    qboolean teammate = qfalse;
+    int viewid, count = 4;
 
+    ent->client->ps.stats[STAT_LAYOUTS] = 0;
     if (ent->health <= 0 || level.intermission_framenum || ent->client->layout) {
         ent->client->ps.stats[STAT_LAYOUTS] |= 1;
     }
 
-    // score
-    switch (ARENA(ent)->scoremode) {
-    case SCOREMODE_FRAGS:
-        ent->client->ps.stats[STAT_FRAGS] = ent->client->pers.frags;
-        break;
-    case SCOREMODE_DAMAGE:
-        ent->client->ps.stats[STAT_FRAGS] = ent->client->pers.damage;
-        break;
-    default:
-        ent->client->ps.stats[STAT_FRAGS] = ent->client->pers.score;
-    }
-
     ent->client->ps.stats[STAT_SPECTATOR] = 0;
     ent->client->ps.stats[STAT_CHASE] = 0;
 
     if (level.intermission_framenum || ARENA(ent)->round_intermission_start) {
         ent->client->ps.stats[STAT_VIEWID] = 0;
+        return count;
+    }
+
+    if (ent->client->pers.connected == CONN_SPAWNED) {
+        // countdown
+        if (ent->client->pers.arena->state == ARENA_STATE_COUNTDOWN) {
+            ent->client->ps.stats[STAT_COUNTDOWN] = ARENA(ent)->countdown;
+        } else {
+            ent->client->ps.stats[STAT_COUNTDOWN] = 0;
+        }
     } else {
-        if (ent->client->pers.connected == CONN_SPAWNED) {
-            // countdown
-            if (ent->client->pers.arena->state == ARENA_STATE_COUNTDOWN) {
-                ent->client->ps.stats[STAT_COUNTDOWN] = ARENA(ent)->countdown;
-            } else {
-                ent->client->ps.stats[STAT_COUNTDOWN] = 0;
-            }
+        if (ent->client->pers.connected == CONN_SPECTATOR) {
+            ent->client->ps.stats[STAT_SPECTATOR] = CS_SPECMODE;
         } else {
-            if (ent->client->pers.connected == CONN_SPECTATOR) {
-                ent->client->ps.stats[STAT_SPECTATOR] = CS_SPECMODE;
-            } else {
-                ent->client->ps.stats[STAT_SPECTATOR] = CS_PREGAME;
-            }
+            ent->client->ps.stats[STAT_SPECTATOR] = CS_PREGAME;
         }
-        if (ent->client->pers.noviewid) {
-            ent->client->ps.stats[STAT_VIEWID] = 0;
+    }
+    count++;
+
+    if (ent->client->pers.noviewid) {
+        ent->client->ps.stats[STAT_VIEWID] = 0;
+    } else {
+        viewid = G_GetPlayerIdView(ent, &teammate);
+        if (teammate) {
+            ent->client->ps.stats[STAT_VIEWID] = viewid;
         } else {
-            viewid = G_GetPlayerIdView(ent, &teammate);
-            if (teammate) {
-                ent->client->ps.stats[STAT_VIEWID] = viewid;
-            } else {
-                ent->client->ps.stats[STAT_VIEWID] = 0;
-            }
+            ent->client->ps.stats[STAT_VIEWID] = 0;
         }
     }
+    return count;
+}
 
-    if (level.vote.proposal && VF(SHOW)) {
-        ent->client->ps.stats[STAT_VOTE_PROPOSAL] = CS_VOTE_PROPOSAL;
-        ent->client->ps.stats[STAT_VOTE_COUNT] = CS_VOTE_COUNT;
-    } else if (ARENA(ent)->vote.proposal) {
+/**
+ * Vote, ready and round configstring pointers
+ */
+static int G_StatsRound(edict_t *ent, qboolean vote, int ready) {
+    if (vote) {
         ent->client->ps.stats[STAT_VOTE_PROPOSAL] = CS_VOTE_PROPOSAL;
         ent->client->ps.stats[STAT_VOTE_COUNT] = CS_VOTE_COUNT;
     } else {
         ent->client->ps.stats[STAT_VOTE_PROPOSAL] = 0;
         ent->client->ps.stats[STAT_VOTE_COUNT] = 0;
     }
+    ent->client->ps.stats[STAT_READY] = ready;
+    ent->client->ps.stats[STAT_MATCH_STATUS] = CS_MATCH_STATUS;
+    ent->client->ps.stats[STAT_ROUND] = CS_ROUND;
+    return 5;
+}
 
-    if (ARENA(ent)->state == ARENA_STATE_WARMUP) {
-        if (TEAM(ent)) {
-            if (!ent->client->pers.ready) {
-                ent->client->ps.stats[STAT_READY] = CS_READY;
-            } else {
-                ent->client->ps.stats[STAT_READY] = CS_READY_WAIT;
-            }
-        } else {
-            ent->client->ps.stats[STAT_READY] = 0;
-        }
-    } else {
-        ent->client->ps.stats[STAT_READY] = 0;
+/**
+ * Ammo counts for every weapon, team players only
+ */
+static int G_StatsAmmoHud(edict_t *ent) {
+    ent->client->ps.stats[STAT_AMMO_BULLETS] = ent->client->inventory[ITEM_BULLETS];
+    ent->client->ps.stats[STAT_AMMO_SHELLS] = ent->client->inventory[ITEM_SHELLS];
+    ent->client->ps.stats[STAT_AMMO_GRENADES] = ent->client->inventory[ITEM_GRENADES];
+    ent->client->ps.stats[STAT_AMMO_CELLS] = ent->client->inventory[ITEM_CELLS];
+    ent->client->ps.stats[STAT_AMMO_ROCKETS] = ent->client->inventory[ITEM_ROCKETS];
+    ent->client->ps.stats[STAT_AMMO_SLUGS] = ent->client->inventory[ITEM_SLUGS];
+    return 6;
+}
+
+/**
+ * Set playerstats stats for each player.
+ *
+ * This is called every server frame. Each group of stats is only rebuilt
+ * when the inputs it was last built from changed. If anything else wrote to
+ * ps.stats since last time (chasecam, respawn) everything is rebuilt.
+ */
+void G_SetStats(edict_t *ent) {
+    gclient_t       *client = ent->client;
+    statcache_t     *c = &client->statcache;
+    arena_t         *arena = ARENA(ent);
+    int             index, power_armor_type;
+    int             ammo, score, ready;
+    qboolean        vote, timer, team;
+    uint32_t        dirty = 0;
+    int             written = 0, skipped = 0;
+
+    if (hud_stats.last_frame != level.framenum) {
+        hud_stats.last_frame = level.framenum;
+        hud_stats.frames++;
     }
+    hud_stats.calls++;
 
-    ent->client->ps.stats[STAT_MATCH_STATUS] = CS_MATCH_STATUS;
+    // flashes are set earlier in the frame, don't count them as tampering
+    c->stats[STAT_FLASHES] = client->ps.stats[STAT_FLASHES];
+    if (!c->valid || memcmp(c->stats, client->ps.stats, sizeof(c->stats))) {
+        dirty = STATS_ALL;
+        c->valid = qtrue;
+        hud_stats.rebuilds++;
+    }
 
-    if (TEAM(ent)) {
-        ent->client->ps.stats[STAT_AMMO_BULLETS] = ent->client->inventory[ITEM_BULLETS];
-        ent->client->ps.stats[STAT_AMMO_SHELLS] = ent->client->inventory[ITEM_SHELLS];
-        ent->client->ps.stats[STAT_AMMO_GRENADES] = ent->client->inventory[ITEM_GRENADES];
-        ent->client->ps.stats[STAT_AMMO_CELLS] = ent->client->inventory[ITEM_CELLS];
-        ent->client->ps.stats[STAT_AMMO_ROCKETS] = ent->client->inventory[ITEM_ROCKETS];
-        ent->client->ps.stats[STAT_AMMO_SLUGS] = ent->client->inventory[ITEM_SLUGS];
+    if (ent->health != c->health) {
+        dirty |= STATS_HEALTH;
     }
 
-    ent->client->ps.stats[STAT_ROUND] = CS_ROUND;
+    ammo = client->ammo_index ? client->inventory[client->ammo_index] : 0;
+    if (client->ammo_index != c->ammo_index || ammo != c->ammo || client->weapon != c->weapon) {
+        dirty |= STATS_AMMO;
+    }
+
+    // armor
+    power_armor_type = PowerArmorIndex(ent);
+    if (power_armor_type && !client->inventory[ITEM_CELLS]) {
+        // ran out of cells for power armor
+        ent->flags &= ~FL_POWER_ARMOR;
+        gi.sound(ent, CHAN_ITEM, level.sounds.power[1], 1, ATTN_NORM, 0);
+        power_armor_type = 0;
+    }
+    index = ArmorIndex(ent);
+    if (power_armor_type || c->power_armor || index != c->armor_index ||
+            (index && client->inventory[index] != c->armor)) {
+        dirty |= STATS_ARMOR;
+    }
+
+    timer = client->quad_framenum > level.framenum ||
+            client->enviro_framenum > level.framenum ||
+            client->breather_framenum > level.framenum;
+    if (timer || c->timer) {
+        dirty |= STATS_TIMER;
+    }
+
+    if (client->selected_item != c->selected_item) {
+        dirty |= STATS_SELECTED;
+    }
+
+    // score
+    switch (arena->scoremode) {
+    case SCOREMODE_FRAGS:
+        score = client->pers.frags;
+        break;
+    case SCOREMODE_DAMAGE:
+        score = client->pers.damage;
+        break;
+    default:
+        score = client->pers.score;
+    }
+    if (score != c->score) {
+        dirty |= STATS_SCORE;
+    }
+
+    vote = (level.vote.proposal && VF(SHOW)) || arena->vote.proposal;
+    ready = 0;
+    if (arena->state == ARENA_STATE_WARMUP && TEAM(ent)) {
+        ready = (client->pers.ready) ? CS_READY_WAIT : CS_READY;
+    }
+    if (vote != c->vote || ready != c->ready) {
+        dirty |= STATS_ROUND;
+    }
+
+    team = (TEAM(ent) != NULL);
+    if (team && (!c->team || memcmp(&client->inventory[ITEM_SHELLS],
+            c->ammohud, sizeof(c->ammohud)) || client->inventory[ITEM_GRENADES] != c->grenades)) {
+        dirty |= STATS_AMMOHUD;
+    }
+
+    if (dirty & STATS_HEALTH) {
+        written += G_StatsHealth(ent);
+    } else {
+        skipped += 2;
+    }
+    if (dirty & STATS_AMMO) {
+        written += G_StatsAmmo(ent);
+    } else {
+        skipped += 3;
+    }
+    if (dirty & STATS_ARMOR) {
+        written += G_StatsArmor(ent, power_armor_type, index);
+    } else {
+        skipped += 2;
+    }
+    if (dirty & STATS_TIMER) {
+        written += G_StatsTimer(ent);
+    } else {
+        skipped += 2;
+    }
+    if (dirty & STATS_SELECTED) {
+        written += G_StatsSelected(ent);
+    } else {
+        skipped += 2;
+    }
+    if (dirty & STATS_SCORE) {
+        written += G_StatsScore(ent, score);
+    } else {
+        skipped += 1;
+    }
+    written += G_StatsView(ent);
+    if (dirty & STATS_ROUND) {
+        written += G_StatsRound(ent, vote, ready);
+    } else {
+        skipped += 5;
+    }
+    if (team) {
+        if (dirty & STATS_AMMOHUD) {
+            written += G_StatsAmmoHud(ent);
+        } else {
+            skipped += 6;
+        }
+    }
+
+    // remember what this frame was built from
+    c->health = ent->health;
+    c->ammo_index = client->ammo_index;
+    c->ammo = ammo;
+    c->weapon = client->weapon;
+    c->power_armor = power_armor_type;
+    c->armor_index = index;
+    c->armor = index ? client->inventory[index] : 0;
+    c->timer = timer;
+    c->selected_item = client->selected_item;
+    c->score = score;
+    c->vote = vote;
+    c->ready = ready;
+    c->team = team;
+    memcpy(c->ammohud, &client->inventory[ITEM_SHELLS], sizeof(c->ammohud));
+    c->grenades = client->inventory[ITEM_GRENADES];
+    memcpy(c->stats, client->ps.stats, sizeof(c->stats));
+
+    hud_stats.writes += written;
+    hud_stats.skipped += skipped;
 }
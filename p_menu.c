@@ -19,59 +19,184 @@
  */
 #include "g_local.h"
 
+#define MENU_HEADER     "xv 32 yv 8 picn inventory "
+#define MENU_LAYOUTS    32
+
 /**
- * Send the menu layout to the a particular client
+ * A menu rendered without a cursor. Everyone looking at the same menu (the
+ * arena list, the join menu of one arena) shares one of these, so moving the
+ * cursor only has to format the highlighted line.
  */
-static void PMenu_Write(edict_t *ent) {
-    char string[MAX_STRING_CHARS];
-    char entry[MAX_STRING_CHARS];
-    int i;
-    size_t total, len;
-    pmenu_entry_t *p;
-    int x;
-    pmenu_t *menu = &ent->client->menu;
-    const char *t;
+typedef struct {
+    uint32_t    serial;     // 0 when unused, bumped on every rebuild
+    uint32_t    hash;
+    size_t      siglen;
+    char        sig[MAX_STRING_CHARS];          // entry texts and alignment
+    size_t      len;
+    char        string[MAX_STRING_CHARS];       // all lines, no header
+    uint16_t    ofs[MAX_MENU_ENTRIES + 1];      // line i is string[ofs[i]..ofs[i+1]]
+} pmenu_layout_t;
+
+static pmenu_layout_t   menu_layouts[MENU_LAYOUTS];
+static uint32_t         menu_serial;
+static int              menu_next;
+
+/**
+ * Format a single menu line
+ */
+static size_t PMenu_Line(char *buf, size_t size, const pmenu_entry_t *p, int i, qboolean cursor) {
+    const char *t = p->text;
     qboolean alt;
+    size_t len;
+    int x;
+
+    if (*t == '*') {
+        alt = qtrue;
+        t++;
+    } else {
+        alt = qfalse;
+    }
+    len = strlen(t);
+    if (p->align == PMENU_ALIGN_CENTER) {
+        x = 196 / 2 - len * 4 + 64;
+    } else if (p->align == PMENU_ALIGN_RIGHT) {
+        x = 64 + (196 - len * 8);
+    } else {
+        x = 64;
+    }
+    if (cursor) {
+        x -= 8;
+        alt ^= 1;
+    }
+
+    return Q_snprintf(buf, size, "yv %d xv %d string%s \"%s%s\" ",
+            32 + i * 8, x, alt ? "2" : "", cursor ? "\x0d" : "", t);
+}
+
+/**
+ * Find the shared layout matching this menu's entries, rendering it into the
+ * oldest slot if nobody has it yet.
+ *
+ * The result is remembered in the menu until PMenu_Open() is called again, so
+ * entries must only be changed between PMenu_Open() and the next update.
+ */
+static const pmenu_layout_t *PMenu_Layout(pmenu_t *menu) {
+    char sig[MAX_STRING_CHARS], line[MAX_STRING_CHARS];
+    pmenu_layout_t *l;
+    pmenu_entry_t *p;
+    size_t siglen, len;
+    uint32_t hash;
+    int i;
+
+    if (menu->serial && menu->layout < MENU_LAYOUTS &&
+            menu_layouts[menu->layout].serial == menu->serial) {
+        return &menu_layouts[menu->layout];
+    }
+
+    // signature: "<align><text>\0" for every line, blank lines just "\0"
+    siglen = 0;
+    for (i = 0, p = menu->entries; i < MAX_MENU_ENTRIES; i++, p++) {
+        if (p->text && p->text[0]) {
+            len = strlen(p->text);
+            if (siglen + len + 2 > sizeof(sig)) {
+                break;
+            }
+            sig[siglen++] = '0' + p->align;
+            memcpy(sig + siglen, p->text, len);
+            siglen += len;
+        }
+        sig[siglen++] = 0;
+    }
+
+    hash = 2166136261u;
+    for (len = 0; len < siglen; len++) {
+        hash = (hash ^ (byte)sig[len]) * 16777619u;
+    }
+
+    for (i = 0, l = menu_layouts; i < MENU_LAYOUTS; i++, l++) {
+        if (l->serial && l->hash == hash && l->siglen == siglen &&
+                !memcmp(l->sig, sig, siglen)) {
+            menu->layout = i;
+            menu->serial = l->serial;
+            return l;
+        }
+    }
 
-    memset(string, 0, sizeof(string));
-    memset(entry, 0, sizeof(entry));
+    // render it
+    i = menu_next;
+    menu_next = (menu_next + 1) % MENU_LAYOUTS;
+    l = &menu_layouts[i];
 
-    strcpy(string, "xv 32 yv 8 picn inventory ");
-    total = strlen(string);
+    l->serial = ++menu_serial ? menu_serial : ++menu_serial;
+    l->hash = hash;
+    l->siglen = siglen;
+    memcpy(l->sig, sig, siglen);
+    l->len = 0;
 
     for (i = 0, p = menu->entries; i < MAX_MENU_ENTRIES; i++, p++) {
+        l->ofs[i] = l->len;
         if (!p->text || !p->text[0]) {
             continue; // blank line
         }
-        t = p->text;
-        if (*t == '*') {
-            alt = qtrue;
-            t++;
-        } else {
-            alt = qfalse;
-        }
-        if (p->align == PMENU_ALIGN_CENTER) {
-            x = 196 / 2 - strlen(t) * 4 + 64;
-        } else if (p->align == PMENU_ALIGN_RIGHT) {
-            x = 64 + (196 - strlen(t) * 8);
-        } else {
-            x = 64;
+        len = PMenu_Line(line, sizeof(line), p, i, qfalse);
+        if (len >= sizeof(line)) {
+            continue;
         }
-        if (menu->cur == i) {
-            x -= 8;
-            alt ^= 1;
+        if (strlen(MENU_HEADER) + l->len + len >= MAX_STRING_CHARS) {
+            continue;
         }
+        memcpy(l->string + l->len, line, len);
+        l->len += len;
+    }
+    l->ofs[i] = l->len;
+    l->string[l->len] = 0;
 
-        len = Q_snprintf(entry, sizeof(entry), "yv %d xv %d string%s \"%s%s\" ",
-                32 + i * 8, x, alt ? "2" : "", menu->cur == i ? "\x0d" : "", t);
-        if (len >= sizeof(entry)) {
-            continue;
+    menu->layout = l - menu_layouts;
+    menu->serial = l->serial;
+    return l;
+}
+
+/**
+ * Send the menu layout to the a particular client
+ */
+static void PMenu_Write(edict_t *ent) {
+    char string[MAX_STRING_CHARS];
+    char entry[MAX_STRING_CHARS];
+    pmenu_t *menu = &ent->client->menu;
+    const pmenu_layout_t *l;
+    size_t total, len;
+    int cur, i;
+
+    l = PMenu_Layout(menu);
+
+    total = strlen(MENU_HEADER);
+    memcpy(string, MENU_HEADER, total);
+
+    cur = menu->cur;
+    if (cur < 0 || cur >= MAX_MENU_ENTRIES || !menu->entries[cur].text ||
+            !menu->entries[cur].text[0]) {
+        cur = MAX_MENU_ENTRIES;
+    }
+
+    // everything above the cursor
+    memcpy(string + total, l->string, l->ofs[cur]);
+    total += l->ofs[cur];
+
+    if (cur < MAX_MENU_ENTRIES) {
+        // the highlighted line, then as much of the rest as fits
+        len = PMenu_Line(entry, sizeof(entry), &menu->entries[cur], cur, qtrue);
+        if (len < sizeof(entry) && total + len < MAX_STRING_CHARS) {
+            memcpy(string + total, entry, len);
+            total += len;
         }
-        if (total + len >= MAX_STRING_CHARS) {
-            break;
+        for (i = cur + 1; i < MAX_MENU_ENTRIES; i++) {
+            len = l->ofs[i + 1] - l->ofs[i];
+            if (total + len >= MAX_STRING_CHARS) {
+                break;
+            }
+            memcpy(string + total, l->string + l->ofs[i], len);
+            total += len;
         }
-        memcpy(string + total, entry, len);
-        total += len;
     }
 
     string[total] = 0;
@@ -96,6 +221,7 @@ void PMenu_Open(edict_t *ent, const pmenu_entry_t *entries) {
         }
     }
 
+    menu->serial = 0;
     menu->cur = -1;
     for (i = 0, p = menu->entries; i < MAX_MENU_ENTRIES; i++, p++) {
         if (p->select) {
@@ -31,6 +31,35 @@ static float    bobmove;
 static int      bobcycle;       // odd cycles are right foot going forward
 static float    bobfracsin;     // sin(bobfrac*M_PI)
 
+viewstats_t     view_stats;
+
+/**
+ * Get the forward/right/up vectors for the client's v_angle. The basis is
+ * cached in the client and only rebuilt when v_angle actually changes, so
+ * the view, hud and weapon code can all ask for it in the same frame
+ * without redoing 6 sin/cos calls each time. Any output can be NULL.
+ */
+void P_ViewVectors(gclient_t *client, vec3_t f, vec3_t r, vec3_t u) {
+    if (client->v_basis_valid && VectorCompare(client->v_angle, client->v_basis_angle)) {
+        view_stats.hits++;
+    } else {
+        AngleVectors(client->v_angle, client->v_forward, client->v_right, client->v_up);
+        VectorCopy(client->v_angle, client->v_basis_angle);
+        client->v_basis_valid = qtrue;
+        view_stats.misses++;
+    }
+
+    if (f) {
+        VectorCopy(client->v_forward, f);
+    }
+    if (r) {
+        VectorCopy(client->v_right, r);
+    }
+    if (u) {
+        VectorCopy(client->v_up, u);
+    }
+}
+
 /**
  *
  */
@@ -399,7 +428,7 @@ static void P_CalcBlend(edict_t *ent) {
     if (ent->client->quad_framenum > level.framenum) {
         remaining = ent->client->quad_framenum - level.framenum;
         if (remaining == 3 * HZ) {  // beginning to fade
-            gi.sound(ent, CHAN_ITEM, gi.soundindex("items/damage2.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_ITEM, level.sounds.damage[1], 1, ATTN_NORM, 0);
         }
         if (remaining > 3 * HZ || ((remaining / FRAMEDIV) & 4)) {
             P_AddBlend(0, 0, 1, 0.08, ent->client->ps.blend);
@@ -407,7 +436,7 @@ static void P_CalcBlend(edict_t *ent) {
     } else if (ent->client->invincible_framenum > level.framenum) {
         remaining = ent->client->invincible_framenum - level.framenum;
         if (remaining == 3 * HZ) {  // beginning to fade
-            gi.sound(ent, CHAN_ITEM, gi.soundindex("items/protect2.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_ITEM, level.sounds.protect[1], 1, ATTN_NORM, 0);
         }
         if (remaining > 3 * HZ || ((remaining / FRAMEDIV) & 4)) {
             P_AddBlend(1, 1, 0, 0.08, ent->client->ps.blend);
@@ -415,7 +444,7 @@ static void P_CalcBlend(edict_t *ent) {
     } else if (ent->client->enviro_framenum > level.framenum) {
         remaining = ent->client->enviro_framenum - level.framenum;
         if (remaining == 3 * HZ) {  // beginning to fade
-            gi.sound(ent, CHAN_ITEM, gi.soundindex("items/airout.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_ITEM, level.sounds.airout, 1, ATTN_NORM, 0);
         }
         if (remaining > 3 * HZ || ((remaining / FRAMEDIV) & 4)) {
             P_AddBlend(0, 1, 0, 0.08, ent->client->ps.blend);
@@ -423,7 +452,7 @@ static void P_CalcBlend(edict_t *ent) {
     } else if (ent->client->breather_framenum > level.framenum) {
         remaining = ent->client->breather_framenum - level.framenum;
         if (remaining == 3 * HZ) {  // beginning to fade
-            gi.sound(ent, CHAN_ITEM, gi.soundindex("items/airout.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_ITEM, level.sounds.airout, 1, ATTN_NORM, 0);
         }
         if (remaining > 3 * HZ || ((remaining / FRAMEDIV) & 4)) {
             P_AddBlend(0.4, 1, 0.4, 0.04, ent->client->ps.blend);
@@ -933,7 +962,7 @@ void ClientEndServerFrame(edict_t *ent) {
         ent->client->ps.pmove.velocity[i] = ent->velocity[i] * 8.0;
     }
 
-    AngleVectors(ent->client->v_angle, forward, right, up);
+    P_ViewVectors(ent->client, forward, right, up);
 
     // burn from lava, etc
     P_WorldEffects();
@@ -142,7 +142,7 @@ void ChangeWeapon(edict_t *ent) {
     ent->client->weaponstate = WEAPON_ACTIVATING;
     ent->client->weaponframe = 0;
     ent->client->ps.gunframe = 0;
-    ent->client->ps.gunindex = gi.modelindex(ent->client->weapon->view_model);
+    ent->client->ps.gunindex = G_ItemViewModel(ent->client->weapon);
 
     ent->client->anim_priority = ANIM_PAIN;
     if (ent->client->ps.pmove.pm_flags & PMF_DUCKED) {
@@ -398,7 +398,7 @@ static void Weapon_Generic(edict_t *ent, int FRAME_ACTIVATE_LAST, int FRAME_FIRE
         for (n = 0; fire_frames[n]; n++) {
             if (ent->client->weaponframe == fire_frames[n]) {
                 if (ent->client->quad_framenum > level.framenum) {
-                    gi.sound(ent, CHAN_ITEM, gi.soundindex("items/damage3.wav"), 1, ATTN_NORM, 0);
+                    gi.sound(ent, CHAN_ITEM, level.sounds.damage[2], 1, ATTN_NORM, 0);
                 }
 
                 fire(ent);
@@ -449,7 +449,7 @@ static void weapon_grenade_fire(edict_t *ent, qboolean held) {
     }
 
     VectorSet(offset, 8, 8, ent->viewheight - 8);
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     P_ProjectSource(ent->client, ent->s.origin, offset, forward, right, start);
 
     timer = ent->client->grenade_framenum - level.framenum;
@@ -460,7 +460,7 @@ static void weapon_grenade_fire(edict_t *ent, qboolean held) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_GRENADES].atts++;
+    G_PlayerStats(ent)->frags[FRAG_GRENADES].atts++;
     ent->client->grenade_framenum = level.framenum + 1 * HZ;
 
     if (ent->deadflag || ent->s.modelindex != 255) { // VWep animations screw up corpses
@@ -525,13 +525,13 @@ void Weapon_Grenade(edict_t *ent) {
 
     if (ent->client->weaponstate == WEAPON_FIRING) {
         if (ent->client->weaponframe == 5) {
-            gi.sound(ent, CHAN_WEAPON, gi.soundindex("weapons/hgrena1b.wav"), 1, ATTN_NORM, 0);
+            gi.sound(ent, CHAN_WEAPON, level.sounds.hgrenade_throw, 1, ATTN_NORM, 0);
         }
 
         if (ent->client->weaponframe == 11) {
             if (!ent->client->grenade_framenum) {
                 ent->client->grenade_framenum = level.framenum + GRENADE_TIMER + 2;
-                ent->client->weapon_sound = gi.soundindex("weapons/hgrenc1b.wav");
+                ent->client->weapon_sound = level.sounds.hgrenade_tick;
             }
 
             // they waited too long, detonate it in their hand
@@ -591,7 +591,7 @@ static void weapon_grenadelauncher_fire(edict_t *ent) {
     }
 
     VectorSet(offset, 8, 8, ent->viewheight - 8);
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     P_ProjectSource(ent->client, ent->s.origin, offset, forward, right, start);
 
     VectorScale(forward, -2, ent->client->kick_origin);
@@ -599,10 +599,10 @@ static void weapon_grenadelauncher_fire(edict_t *ent) {
 
     fire_grenade(ent, start, forward, damage, 600, 2.5 * HZ, radius);
 
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_GRENADE | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_GRENADE | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     ent->client->weaponframe++;
 
@@ -614,7 +614,7 @@ static void weapon_grenadelauncher_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_GRENADELAUNCHER].atts++;
+    G_PlayerStats(ent)->frags[FRAG_GRENADELAUNCHER].atts++;
 }
 
 /**
@@ -645,7 +645,7 @@ static void weapon_rocketlauncher_fire(edict_t *ent) {
         radius_damage *= 4;
     }
 
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     VectorScale(forward, -2, ent->client->kick_origin);
     ent->client->kick_angles[0] = -1;
     VectorSet(offset, 8, 8, ent->viewheight - 8);
@@ -653,10 +653,10 @@ static void weapon_rocketlauncher_fire(edict_t *ent) {
     fire_rocket(ent, start, forward, damage, 650, damage_radius, radius_damage);
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_ROCKET | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_ROCKET | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     ent->client->weaponframe++;
 
@@ -668,7 +668,7 @@ static void weapon_rocketlauncher_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_ROCKETLAUNCHER].atts++;
+    G_PlayerStats(ent)->frags[FRAG_ROCKETLAUNCHER].atts++;
 }
 
 /**
@@ -692,7 +692,7 @@ static void blaster_fire(edict_t *ent, vec3_t g_offset, int damage, qboolean hyp
     if (is_quad) {
         damage *= 4;
     }
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     VectorSet(offset, 24, 8, ent->viewheight - 8);
     VectorAdd(offset, g_offset, offset);
     P_ProjectSource(ent->client, ent->s.origin, offset, forward, right, start);
@@ -701,14 +701,14 @@ static void blaster_fire(edict_t *ent, vec3_t g_offset, int damage, qboolean hyp
     fire_blaster(ent, start, forward, damage, 1000, effect, hyper);
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
     if (hyper) {
-        gi.WriteByte(MZ_HYPERBLASTER | is_silenced);
+        G_WriteByte(MZ_HYPERBLASTER | is_silenced);
     } else {
-        gi.WriteByte(MZ_BLASTER | is_silenced);
+        G_WriteByte(MZ_BLASTER | is_silenced);
     }
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     if (ent->client->silencer_shots) {
         ent->client->silencer_shots--;
@@ -720,7 +720,7 @@ static void blaster_fire(edict_t *ent, vec3_t g_offset, int damage, qboolean hyp
  */
 static void weapon_blaster_fire(edict_t *ent) {
     blaster_fire(ent, vec3_origin, 15, qfalse, EF_BLASTER);
-    ent->client->resp.frags[FRAG_BLASTER].atts++;
+    G_PlayerStats(ent)->frags[FRAG_BLASTER].atts++;
     ent->client->weaponframe++;
 }
 
@@ -742,7 +742,7 @@ static void weapon_hyperblaster_fire(edict_t *ent) {
     vec3_t  offset;
     int     effect;
 
-    ent->client->weapon_sound = gi.soundindex("weapons/hyprbl1a.wav");
+    ent->client->weapon_sound = level.sounds.hyperblaster_loop;
 
     if (!(ent->client->buttons & BUTTON_ATTACK)) {
         ent->client->weaponframe++;
@@ -765,7 +765,7 @@ static void weapon_hyperblaster_fire(edict_t *ent) {
                 ent->client->inventory[ent->client->ammo_index]--;
             }
 
-            ent->client->resp.frags[FRAG_HYPERBLASTER].atts++;
+            G_PlayerStats(ent)->frags[FRAG_HYPERBLASTER].atts++;
             ent->client->anim_priority = ANIM_ATTACK;
             if (ent->client->ps.pmove.pm_flags & PMF_DUCKED) {
                 ent->client->anim_start = FRAME_crattak1;
@@ -782,7 +782,7 @@ static void weapon_hyperblaster_fire(edict_t *ent) {
     }
 
     if (ent->client->weaponframe == 12) {
-        gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/hyprbd1a.wav"), 1, ATTN_NORM, 0);
+        gi.sound(ent, CHAN_AUTO, level.sounds.hyperblaster_down, 1, ATTN_NORM, 0);
         ent->client->weapon_sound = 0;
     }
 }
@@ -848,10 +848,10 @@ static void weapon_machinegun_fire(edict_t *ent) {
     fire_bullet(ent, start, forward, damage, kick, DEFAULT_BULLET_HSPREAD, DEFAULT_BULLET_VSPREAD, MOD_MACHINEGUN);
     G_EndDamage();
 
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_MACHINEGUN | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_MACHINEGUN | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     if (ent->client->silencer_shots) {
         ent->client->silencer_shots--;
@@ -861,7 +861,7 @@ static void weapon_machinegun_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_MACHINEGUN].atts++;
+    G_PlayerStats(ent)->frags[FRAG_MACHINEGUN].atts++;
 
     ent->client->anim_priority = ANIM_ATTACK;
     if (ent->client->ps.pmove.pm_flags & PMF_DUCKED) {
@@ -897,7 +897,7 @@ static void weapon_chaingun_fire(edict_t *ent) {
     int         kick = 2;
 
     if (ent->client->weaponframe == 5) {
-        gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/chngnu1a.wav"), 1, ATTN_IDLE, 0);
+        gi.sound(ent, CHAN_AUTO, level.sounds.chaingun_up, 1, ATTN_IDLE, 0);
     }
 
     if ((ent->client->weaponframe == 14) && !(ent->client->buttons & BUTTON_ATTACK)) {
@@ -913,9 +913,9 @@ static void weapon_chaingun_fire(edict_t *ent) {
 
     if (ent->client->weaponframe == 22) {
         ent->client->weapon_sound = 0;
-        gi.sound(ent, CHAN_AUTO, gi.soundindex("weapons/chngnd1a.wav"), 1, ATTN_IDLE, 0);
+        gi.sound(ent, CHAN_AUTO, level.sounds.chaingun_down, 1, ATTN_IDLE, 0);
     } else {
-        ent->client->weapon_sound = gi.soundindex("weapons/chngnl1a.wav");
+        ent->client->weapon_sound = level.sounds.chaingun_loop;
     }
 
     ent->client->anim_priority = ANIM_ATTACK;
@@ -961,7 +961,7 @@ static void weapon_chaingun_fire(edict_t *ent) {
     G_BeginDamage();
     for (i = 0; i < shots; i++) {
         // get start / end positions
-        AngleVectors(ent->client->v_angle, forward, right, up);
+        P_ViewVectors(ent->client, forward, right, up);
         r = 7 + crandom() * 4;
         u = crandom() * 4;
         VectorSet(offset, 0, r, u + ent->viewheight - 8);
@@ -972,10 +972,10 @@ static void weapon_chaingun_fire(edict_t *ent) {
     G_EndDamage();
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte((MZ_CHAINGUN1 + shots - 1) | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte((MZ_CHAINGUN1 + shots - 1) | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     if (ent->client->silencer_shots) {
         ent->client->silencer_shots--;
@@ -985,7 +985,7 @@ static void weapon_chaingun_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index] -= shots;
     }
 
-    ent->client->resp.frags[FRAG_CHAINGUN].atts++;
+    G_PlayerStats(ent)->frags[FRAG_CHAINGUN].atts++;
 }
 
 /**
@@ -1013,7 +1013,7 @@ static void weapon_shotgun_fire(edict_t *ent) {
         return;
     }
 
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     VectorScale(forward, -2, ent->client->kick_origin);
     ent->client->kick_angles[0] = -2;
     VectorSet(offset, 0, 8,  ent->viewheight - 8);
@@ -1029,10 +1029,10 @@ static void weapon_shotgun_fire(edict_t *ent) {
     G_EndDamage();
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_SHOTGUN | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_SHOTGUN | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     ent->client->weaponframe++;
 
@@ -1044,7 +1044,7 @@ static void weapon_shotgun_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_SHOTGUN].atts++;
+    G_PlayerStats(ent)->frags[FRAG_SHOTGUN].atts++;
 }
 
 /**
@@ -1068,7 +1068,7 @@ static void weapon_supershotgun_fire(edict_t *ent) {
     int         damage = 6;
     int         kick = 12;
 
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
     VectorScale(forward, -2, ent->client->kick_origin);
     ent->client->kick_angles[0] = -2;
     VectorSet(offset, 0, 8,  ent->viewheight - 8);
@@ -1091,10 +1091,10 @@ static void weapon_supershotgun_fire(edict_t *ent) {
     G_EndDamage();
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_SSHOTGUN | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_SSHOTGUN | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     ent->client->weaponframe++;
 
@@ -1106,7 +1106,7 @@ static void weapon_supershotgun_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index] -= 2;
     }
 
-    ent->client->resp.frags[FRAG_SUPERSHOTGUN].atts++;
+    G_PlayerStats(ent)->frags[FRAG_SUPERSHOTGUN].atts++;
 }
 
 /**
@@ -1134,7 +1134,7 @@ static void weapon_railgun_fire(edict_t *ent) {
         kick *= 4;
     }
 
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
 
     VectorScale(forward, -3, ent->client->kick_origin);
     ent->client->kick_angles[0] = -3;
@@ -1144,10 +1144,10 @@ static void weapon_railgun_fire(edict_t *ent) {
     fire_rail(ent, start, forward, damage, kick);
 
     // send muzzle flash
-    gi.WriteByte(SVC_MUZZLEFLASH);
-    gi.WriteShort(ent - g_edicts);
-    gi.WriteByte(MZ_RAILGUN | is_silenced);
-    gi.multicast(ent->s.origin, MULTICAST_PVS);
+    G_WriteByte(SVC_MUZZLEFLASH);
+    G_WriteShort(ent - g_edicts);
+    G_WriteByte(MZ_RAILGUN | is_silenced);
+    G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
     ent->client->weaponframe++;
 
@@ -1159,7 +1159,7 @@ static void weapon_railgun_fire(edict_t *ent) {
         ent->client->inventory[ent->client->ammo_index]--;
     }
 
-    ent->client->resp.frags[FRAG_RAILGUN].atts++;
+    G_PlayerStats(ent)->frags[FRAG_RAILGUN].atts++;
 }
 
 /**
@@ -1183,10 +1183,10 @@ static void weapon_bfg_fire(edict_t *ent) {
 
     if (ent->client->weaponframe == 9) {
         // send muzzle flash
-        gi.WriteByte(SVC_MUZZLEFLASH);
-        gi.WriteShort(ent - g_edicts);
-        gi.WriteByte(MZ_BFG | is_silenced);
-        gi.multicast(ent->s.origin, MULTICAST_PVS);
+        G_WriteByte(SVC_MUZZLEFLASH);
+        G_WriteShort(ent - g_edicts);
+        G_WriteByte(MZ_BFG | is_silenced);
+        G_ArenaMulticast(ent->s.origin, MULTICAST_PVS, ARENA(ent));
 
         ent->client->weaponframe++;
 
@@ -1207,7 +1207,7 @@ static void weapon_bfg_fire(edict_t *ent) {
         damage *= 4;
     }
 
-    AngleVectors(ent->client->v_angle, forward, right, NULL);
+    P_ViewVectors(ent->client, forward, right, NULL);
 
     VectorScale(forward, -2, ent->client->kick_origin);
 
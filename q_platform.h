@@ -26,6 +26,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #ifdef _WIN32
 #include <io.h>
 #include <direct.h>
+#include <process.h>
 #else
 #include <unistd.h>
 #endif
@@ -57,9 +58,11 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define os_fstat(f, s)      _fstat(f, s)
 #define os_fileno(f)        _fileno(f)
 #define os_access(p, m)     _access(p, m)
+#define os_getpid()         _getpid()
 #define Q_ISREG(m)          (((m) & _S_IFMT) == _S_IFREG)
 #define Q_ISDIR(m)          (((m) & _S_IFMT) == _S_IFDIR)
 #define Q_STATBUF           struct _stat
+#define os_localtime(t, tm) (localtime_s(tm, t) ? NULL : (tm))
 #else
 #define os_mkdir(p)         mkdir(p, 0775)
 #define os_unlink(p)        unlink(p)
@@ -67,9 +70,11 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #define os_fstat(f, s)      fstat(f, s)
 #define os_fileno(f)        fileno(f)
 #define os_access(p, m)     access(p, m)
+#define os_getpid()         getpid()
 #define Q_ISREG(m)          S_ISREG(m)
 #define Q_ISDIR(m)          S_ISDIR(m)
 #define Q_STATBUF           struct stat
+#define os_localtime(t, tm) localtime_r(t, tm)
 #endif
 
 #ifndef F_OK
@@ -112,6 +117,8 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define q_unused            __attribute__((unused))
 
+#define q_thread            __thread
+
 #else /* __GNUC__ */
 
 #define q_printf(f, a)
@@ -133,4 +140,10 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #define q_unused
 
+#ifdef _WIN32
+#define q_thread            __declspec(thread)
+#else
+#define q_thread
+#endif
+
 #endif /* !__GNUC__ */
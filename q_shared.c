@@ -397,18 +397,30 @@ size_t COM_strclr(char *s) {
     return len;
 }
 
+#define SCRATCH_SLOTS   16
+
+static q_thread char        scratch[SCRATCH_SLOTS][MAX_STRING_CHARS];
+static q_thread uint16_t    scratch_index;
+
 /**
- * A shorthand g_snprintf into a statically allocated buffer. Several
- * buffers are maintained internally so that nested va()'s are safe within
- * reasonable limits. This function is not thread safe.
+ * Get the next MAX_STRING_CHARS sized buffer from the calling thread's
+ * scratch ring. Slots get reused once the ring wraps around, so copy the
+ * result somewhere if it needs to stick around. Each thread has its own
+ * ring, so this is safe to call from anywhere.
+ */
+char *Q_ScratchBuffer(void) {
+    return scratch[scratch_index++ % SCRATCH_SLOTS];
+}
+
+/**
+ * A shorthand g_snprintf into a scratch buffer. Several buffers are
+ * maintained per thread so that nested va()'s are safe within reasonable
+ * limits, see Q_ScratchBuffer().
  *
  * This version ganked from Quetoo
  */
 char *va(const char *format, ...) {
-    static char strings[8][MAX_STRING_CHARS];
-    static uint16_t index;
-
-    char *string = strings[index++ % 8];
+    char *string = Q_ScratchBuffer();
 
     va_list args;
 
@@ -419,8 +431,8 @@ char *va(const char *format, ...) {
     return string;
 }
 
-static char     com_token[4][MAX_TOKEN_CHARS];
-static int      com_tokidx;
+static q_thread char    com_token[4][MAX_TOKEN_CHARS];
+static q_thread int     com_tokidx;
 
 /**
  * Parse a token out of a string. Handles C and C++ comments.
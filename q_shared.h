@@ -509,6 +509,7 @@ size_t Q_vscnprintf(char *dest, size_t size, const char *fmt, va_list argptr);
 size_t Q_snprintf(char *dest, size_t size, const char *fmt, ...) q_printf(3, 4);
 size_t Q_scnprintf(char *dest, size_t size, const char *fmt, ...) q_printf(3, 4);
 
+char    *Q_ScratchBuffer(void);
 char    *va(const char *format, ...) q_printf(1, 2);
 
 //=============================================
@@ -0,0 +1,196 @@
+/*
+ Copyright (C) 2017 Packetflinger.com
+
+ This program is free software; you can redistribute it and/or
+ modify it under the terms of the GNU General Public License
+ as published by the Free Software Foundation; either version 2
+ of the License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+ See the GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program; if not, write to the Free Software
+ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+
+*/
+// ra2events.c -- print a match event log written with g_event_log 1
+//
+// usage: ra2events <file.evl> [...]
+//
+// One line per event: frame, arena, event name and its fields. Client
+// numbers are shown with the last name seen for them.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "g_events.h"
+
+#define MAX_CLIENTS     256
+
+static char names[MAX_CLIENTS][17];
+
+static const char *event_names[EV_TOTAL] = {
+    [EV_CLIENT]         = "client",
+    [EV_ROUND_START]    = "round_start",
+    [EV_ROUND_END]      = "round_end",
+    [EV_MATCH_END]      = "match_end",
+    [EV_DAMAGE]         = "damage",
+    [EV_KILL]           = "kill",
+    [EV_PICKUP]         = "pickup",
+};
+
+static const char *name(int client) {
+    static char buffer[2][32];
+    static int index;
+    char *s = buffer[index++ & 1];
+
+    if (client == EVENTS_NOCLIENT) {
+        return "world";
+    }
+    snprintf(s, sizeof(buffer[0]), "%d:%s", client, names[client]);
+    return s;
+}
+
+static const char *team(int t) {
+    static char buffer[8];
+
+    if (t == EVENTS_NOCLIENT) {
+        return "none";
+    }
+    snprintf(buffer, sizeof(buffer), "%d", t);
+    return buffer;
+}
+
+static void print_event(const ev_record_t *rec, const unsigned char *p) {
+    const ev_client_t *client;
+    const ev_round_start_t *start;
+    const ev_roster_t *roster;
+    const ev_round_end_t *end;
+    const ev_match_end_t *match;
+    const ev_damage_t *damage;
+    const ev_kill_t *kill;
+    const ev_pickup_t *pickup;
+    int i;
+
+    printf("%8u %3u ", rec->frame, rec->arena);
+    if (rec->type && rec->type < EV_TOTAL) {
+        printf("%-11s", event_names[rec->type]);
+    } else {
+        printf("unknown %u (%u bytes)\n", rec->type, rec->len);
+        return;
+    }
+
+    switch (rec->type) {
+    case EV_CLIENT:
+        if (rec->len < sizeof(*client)) {
+            break;
+        }
+        client = (const ev_client_t *)p;
+        memcpy(names[client->client], client->name, sizeof(client->name));
+        names[client->client][16] = 0;
+        printf(" %s", name(client->client));
+        break;
+    case EV_ROUND_START:
+        if (rec->len < sizeof(*start)) {
+            break;
+        }
+        start = (const ev_round_start_t *)p;
+        printf(" %u/%u", start->round, start->round_limit);
+        roster = (const ev_roster_t *)(p + sizeof(*start));
+        for (i = 0; i < start->count && sizeof(*start) + (i + 1) * sizeof(*roster) <= rec->len; i++) {
+            printf(" %s@%s", name(roster[i].client), team(roster[i].team));
+        }
+        break;
+    case EV_ROUND_END:
+        if (rec->len < sizeof(*end)) {
+            break;
+        }
+        end = (const ev_round_end_t *)p;
+        printf(" %u winner %s", end->round, team(end->winner));
+        break;
+    case EV_MATCH_END:
+        if (rec->len < sizeof(*match)) {
+            break;
+        }
+        match = (const ev_match_end_t *)p;
+        printf(" winner %s", team(match->winner));
+        break;
+    case EV_DAMAGE:
+        if (rec->len < sizeof(*damage)) {
+            break;
+        }
+        damage = (const ev_damage_t *)p;
+        printf(" %s -> %s mod %u points %d", name(damage->attacker),
+               name(damage->victim), damage->mod, damage->points);
+        break;
+    case EV_KILL:
+        if (rec->len < sizeof(*kill)) {
+            break;
+        }
+        kill = (const ev_kill_t *)p;
+        printf(" %s -> %s mod %u", name(kill->attacker), name(kill->victim), kill->mod);
+        break;
+    case EV_PICKUP:
+        if (rec->len < sizeof(*pickup)) {
+            break;
+        }
+        pickup = (const ev_pickup_t *)p;
+        printf(" %s item %u", name(pickup->client), pickup->item);
+        break;
+    }
+    printf("\n");
+}
+
+static int decode(const char *path) {
+    unsigned char payload[0x10000];
+    ev_header_t header;
+    ev_record_t rec;
+    time_t t;
+    FILE *fp;
+
+    fp = fopen(path, "rb");
+    if (!fp) {
+        perror(path);
+        return 1;
+    }
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+            header.magic != EVENTS_MAGIC || header.version != EVENTS_VERSION) {
+        fprintf(stderr, "%s: not an event log\n", path);
+        fclose(fp);
+        return 1;
+    }
+
+    header.mapname[sizeof(header.mapname) - 1] = 0;
+    t = (time_t)header.time;
+    printf("# %s: map %s, started %s", path, header.mapname, ctime(&t));
+    memset(names, 0, sizeof(names));
+
+    while (fread(&rec, sizeof(rec), 1, fp) == 1) {
+        if (fread(payload, 1, rec.len, fp) != rec.len) {
+            fprintf(stderr, "%s: truncated event\n", path);
+            break;
+        }
+        print_event(&rec, payload);
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int i, ret = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <file.evl> [...]\n", argv[0]);
+        return 1;
+    }
+    for (i = 1; i < argc; i++) {
+        ret |= decode(argv[i]);
+    }
+    return ret;
+}